@@ -1,4 +1,6 @@
 #include "ESP32QRCodeReader.h"
+#include "FramePool.h"
+#include "QRPipeline.h"
 #include <WiFi.h>
 #include "Arduino.h"
 #include <Preferences.h>
@@ -6,13 +8,33 @@
 #define CAMERA_MODEL_AI_THINKER
 #include "camera_pins.h"
 
-void startCameraServer(QueueHandle_t codeQueue);
+void startCameraServer(FramePool *pool);
 void stopCameraServer();
 void qrCodeDetectTask();
 static camera_config_t config;
 
 static ESP32QRCodeReader *reader = NULL;
-static QueueHandle_t qrCodeQueue = NULL;
+static FramePool *framePool = NULL;
+static QRPipeline *pipeline = NULL;
+
+// Frames lent to the detector: one being scanned, one waiting.
+#define FRAME_POOL_SLOTS 2
+
+// A code stays in view without being reported again until it has been
+// gone this long or has moved this far.
+#define DUPLICATE_TTL_MS 2000
+#define DUPLICATE_MOVE_PIXELS 16
+
+// After a code is found, scan only around it (grown by half its size on
+// each side) until this many frames in a row miss.
+#define TRACK_MARGIN_PERCENT 50
+#define TRACK_MAX_MISSES 5
+
+// Cores working on each frame: the detector task's and the other one.
+#define DETECT_THREADS 2
+
+// Core identifying codes; decoding and reporting them use the other.
+#define IDENTIFY_CORE 1
 
 Preferences preferences;
 static int address485 = 0x30;
@@ -77,26 +99,30 @@ void serialPrint(String data){
   digitalWrite(2, LOW);
 }
 
-void loopQrCodeDetect(void* taskData)
-{
+// Sends one line per code with the transceiver enabled only once, so the
+// codes from a frame go out back to back. A payload too long to keep
+// goes out as ERR-TRUNCATED rather than cut short.
+void serialPrintResults(const QRCodeResult *results, int count){
+  digitalWrite(2, HIGH);
+  delayMicroseconds(100);
+  for (int i = 0; i < count; i++) {
+    String data = results[i].truncated ? "ERR-TRUNCATED" : (const char *)results[i].payload;
+    Serial.println(data+countCheckSumAsString(data));
+  }
+  delayMicroseconds(10);
+  digitalWrite(2, LOW);
+}
 
+void startQrCodeDetect()
+{
   reader = new ESP32QRCodeReader();
+  reader->setDuplicateFilter(DUPLICATE_TTL_MS, DUPLICATE_MOVE_PIXELS);
+  reader->setTracking(TRACK_MARGIN_PERCENT, TRACK_MAX_MISSES);
 
-  camera_fb_t *fb = NULL;
-  while (true)
+  pipeline = new QRPipeline(reader, framePool, &config, serialPrintResults);
+  if (!pipeline->start(IDENTIFY_CORE, DETECT_THREADS))
   {
-    if (xQueueReceive(qrCodeQueue, &fb, (TickType_t)pdMS_TO_TICKS(100)))
-    {
-      Serial.println("DEQUEUE");
-      if (reader->qrCodeDetectTask(&config, fb))
-      {
-        //serialPrint("DETECTED:");
-        serialPrint((const char *)reader->buffer);
-      }
-      free(fb->buf);
-      free(fb);
-      fb = NULL;
-    }
+    Serial.println("can't start QR pipeline");
   }
 }
 
@@ -186,7 +212,7 @@ String parsePassword(const String& rest)
 }
 
 bool wifiCommands(const String& addr1, const String& addr2, const String& rest) {
-  if ((!rest.startsWith("WIFI=")) && (!rest.startsWith("WIOFF")) && (!rest.startsWith("WSTAT?"))) {
+  if ((!rest.startsWith("WIFI=")) && (!rest.startsWith("WIOFF")) && (!rest.startsWith("WSTAT?")) && (!rest.startsWith("FSTAT?")) && (!rest.startsWith("PSTAT?"))) {
     return false;
   }
 
@@ -201,7 +227,7 @@ bool wifiCommands(const String& addr1, const String& addr2, const String& rest)
     if (ssid == "" || !wifiConnect(ssid, password)) {
       serialPrint("@" + addr2 + addr1 + "NOK");
     } else {
-      startCameraServer(qrCodeQueue);
+      startCameraServer(framePool);
       delay(100);
       wifi_enabled = 1;
       preferences.putString("wifissid", ssid);
@@ -228,6 +254,31 @@ bool wifiCommands(const String& addr1, const String& addr2, const String& rest)
     } else {
       serialPrint("@" + addr2 + addr1 + "WSTAT=NOK");
     }
+  } else if (rest.startsWith("FSTAT?")) {
+    if (framePool) {
+      FramePoolStats stats = framePool->stats;
+      serialPrint("@" + addr2 + addr1 + "FSTAT=" + String(stats.queued) + "|" + String(stats.scanned) + "|" +
+                  String(stats.dropped) + "|" + String(stats.exhausted));
+    } else {
+      serialPrint("@" + addr2 + addr1 + "FSTAT=NOK");
+    }
+  } else if (rest.startsWith("PSTAT?")) {
+    // Per stage: frames|avg us|max us|wait us|blocked us|max depth, then
+    // the decode and emit queue depths now and the end-to-end latency.
+    if (pipeline) {
+      QRPipelineStats stats = pipeline->stats;
+      String line = "PSTAT=";
+      const QRPipelineStageStats *stages[3] = {&stats.identify, &stats.decode, &stats.emit};
+      for (int i = 0; i < 3; i++) {
+        line += String(stages[i]->frames) + "|" + String(stages[i]->avgUs) + "|" + String(stages[i]->maxUs) + "|" +
+                String(stages[i]->waitUs) + "|" + String(stages[i]->blockedUs) + "|" + String(stages[i]->maxDepth) + ";";
+      }
+      line += String(pipeline->decodeDepth()) + "|" + String(pipeline->emitDepth()) + "|" +
+              String(stats.latencyUs) + "|" + String(stats.maxLatencyUs);
+      serialPrint("@" + addr2 + addr1 + line);
+    } else {
+      serialPrint("@" + addr2 + addr1 + "PSTAT=NOK");
+    }
   }
   return true;
 }
@@ -267,7 +318,8 @@ bool loopProgSelection(const String& addr1, const String& addr2, const String& r
     config.pixel_format = PIXFORMAT_GRAYSCALE;
     config.frame_size = FRAMESIZE_QVGA;
     config.jpeg_quality = 0;
-    config.fb_count = 1;
+    // The stream keeps one frame, the detector pool lends the others.
+    config.fb_count = FRAME_POOL_SLOTS + 1;
     progNum = 1;
 
   } else if (rest.startsWith("PRGBX")) {
@@ -285,8 +337,8 @@ bool loopProgSelection(const String& addr1, const String& addr2, const String& r
   }
 
   if (rest.startsWith("PRGQR")) {
-    qrCodeQueue = xQueueCreate(10, sizeof(camera_fb_t*));
-    xTaskCreatePinnedToCore(loopQrCodeDetect, "qrCodeDetectTask", 40 * 1024, NULL, 5, NULL, 1);
+    framePool = new FramePool(FRAME_POOL_SLOTS);
+    startQrCodeDetect();
   }
 
   serialPrint("@" + addr2 + addr1 + "OK");
@@ -320,7 +372,7 @@ void setup()
   String defaultSsid = preferences.getString("wifissid", "");
   String defaultPass = preferences.getString("wifipass", "");
   if ((defaultSsid != "") && wifiConnect(defaultSsid, defaultPass)) {
-      startCameraServer(qrCodeQueue);
+      startCameraServer(framePool);
       delay(100);
       wifi_enabled = 1;
   }
@@ -5,22 +5,241 @@ ESP32QRCodeReader::ESP32QRCodeReader()
 {
   this->old_width = 0;
   this->old_height = 0;
+  this->batch = (QRCodeBatch*) ps_malloc(sizeof(QRCodeBatch));
+  if (this->batch != NULL)
+  {
+    this->results = this->batch->results;
+  }
+  this->decoder = quirc_decoder_new();
+  if (this->decoder == NULL)
+  {
+      Serial.println("can't create quirc decoder");
+  }
   this->q = quirc_new();
   if (this->q == NULL)
   {
       Serial.println("can't create quirc object");
+      return;
+  }
+
+  // Threshold and scan each row in one go, the frame sits in PSRAM.
+  quirc_set_fused_scan(this->q, 1);
+  // Keep the binarised frame at one bit per pixel in internal RAM, so
+  // the later stages never touch PSRAM for it.
+  quirc_set_bit_plane(this->q, 1);
+  // Fit each grid's transform to its features rather than searching
+  // for it, which costs a tenth of the time and reads skewed codes as
+  // well or better.
+  quirc_set_refinement(this->q, QUIRC_REFINE_FIT);
+}
+
+// 32-bit FNV-1a, carried on from hash when a payload comes in pieces
+static uint32_t hashBytes(const uint8_t *data, int len, uint32_t hash = 2166136261u)
+{
+  for (int i = 0; i < len; i++)
+  {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+void ESP32QRCodeReader::setDuplicateFilter(uint32_t ttlMs, int moveTolerance)
+{
+  this->cacheTtl = ttlMs;
+  this->cacheTolerance = moveTolerance;
+  this->cacheCount = 0;
+}
+
+// Finds a live entry with the given payload or bitmap hash, reported
+// within the move tolerance of (x, y).
+QRCodeCacheEntry *ESP32QRCodeReader::findCached(uint32_t hash, bool payload, int x, int y, uint32_t now)
+{
+  for (int i = 0; i < this->cacheCount; i++)
+  {
+    QRCodeCacheEntry *entry = &this->cache[i];
+
+    if ((payload ? entry->payloadHash : entry->bitmapHash) != hash)
+      continue;
+    if (now - entry->lastSeen > this->cacheTtl)
+      continue;
+    if (abs(entry->centerX - x) > this->cacheTolerance || abs(entry->centerY - y) > this->cacheTolerance)
+      continue;
+
+    return entry;
+  }
+  return NULL;
+}
+
+// Records a reported code, in place of an older report of the same
+// payload if there is one, else of the entry seen least recently.
+void ESP32QRCodeReader::remember(uint32_t payloadHash, uint32_t bitmapHash, int x, int y, uint32_t now)
+{
+  QRCodeCacheEntry *entry = NULL;
+
+  for (int i = 0; i < this->cacheCount; i++)
+  {
+    if (this->cache[i].payloadHash == payloadHash)
+    {
+      entry = &this->cache[i];
+      break;
+    }
+  }
+
+  if (entry == NULL && this->cacheCount < QR_CODE_MAX_RESULTS)
+  {
+    entry = &this->cache[this->cacheCount++];
+  }
+
+  if (entry == NULL)
+  {
+    entry = &this->cache[0];
+    for (int i = 1; i < this->cacheCount; i++)
+    {
+      if (now - this->cache[i].lastSeen > now - entry->lastSeen)
+        entry = &this->cache[i];
+    }
+  }
+
+  entry->payloadHash = payloadHash;
+  entry->bitmapHash = bitmapHash;
+  entry->centerX = x;
+  entry->centerY = y;
+  entry->lastSeen = now;
+}
+
+// Collects the segments of a payload into a result as they are decoded,
+// hashing them on the way, so that the hash covers all of a payload too
+// long to keep.
+struct PayloadWriter
+{
+  QRCodeResult *result;
+  uint32_t hash;
+};
+
+static void writeSegment(void *arg, const struct quirc_segment *seg)
+{
+  PayloadWriter *writer = (PayloadWriter*) arg;
+  QRCodeResult *result = writer->result;
+
+  writer->hash = hashBytes(seg->data, seg->len, writer->hash);
+
+  int room = QR_CODE_MAX_PAYLOAD - 1 - result->payloadLen;
+  int len = seg->len;
+
+  if (len > room)
+  {
+    len = room < 0 ? 0 : room;
+    result->truncated = true;
+  }
+  if (len > 0)
+  {
+    memcpy(result->payload + result->payloadLen, seg->data, len);
+  }
+  result->payloadLen += seg->len;
+}
+
+static void addToBox(int box[4], const struct quirc_code *code)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    box[0] = min(box[0], code->corners[i].x);
+    box[1] = min(box[1], code->corners[i].y);
+    box[2] = max(box[2], code->corners[i].x);
+    box[3] = max(box[3], code->corners[i].y);
   }
 }
 
+void ESP32QRCodeReader::setTracking(int marginPercent, int maxMisses)
+{
+  this->trackMargin = marginPercent;
+  this->trackMaxMisses = maxMisses;
+  this->tracking = false;
+}
+
+bool ESP32QRCodeReader::setThreads(int threads)
+{
+  if (this->q == NULL)
+  {
+    return false;
+  }
+  return quirc_set_threads(this->q, threads) == 0;
+}
+
+// Centres the next scan on the codes just seen, or counts a miss when
+// there were none. Too many misses in a row go back to whole frames.
+void ESP32QRCodeReader::updateTracking(bool seen, const int box[4])
+{
+  if (this->trackMaxMisses == 0)
+  {
+    return;
+  }
+
+  if (!seen)
+  {
+    if (this->tracking && ++this->trackMisses >= this->trackMaxMisses)
+    {
+      this->tracking = false;
+    }
+    return;
+  }
+
+  int margin = max(box[2] - box[0], box[3] - box[1]) * this->trackMargin / 100;
+
+  this->trackBox[0] = box[0] - margin;
+  this->trackBox[1] = box[1] - margin;
+  this->trackBox[2] = box[2] + margin;
+  this->trackBox[3] = box[3] + margin;
+  this->trackMisses = 0;
+  this->tracking = true;
+}
+
 bool ESP32QRCodeReader::qrCodeDetectTask(camera_config_t* camera_config, camera_fb_t *fb)
 {
-  if (camera_config->frame_size > FRAMESIZE_SVGA)
+  if (qrCodeDetectAll(camera_config, fb) == 0)
   {
-    Serial.println("Camera Size err");
     return false;
   }
 
-  uint8_t *image = NULL;
+  // Results are kept to the size of buffer, and cut short only with
+  // truncated set.
+  const QRCodeResult *result = &this->results[0];
+
+  memcpy(this->buffer, result->payload, min(result->payloadLen, QR_CODE_MAX_PAYLOAD - 1) + 1);
+  this->truncated = result->truncated;
+
+  return true;
+}
+
+int ESP32QRCodeReader::qrCodeDetectAll(camera_config_t* camera_config, camera_fb_t *fb)
+{
+  this->resultCount = 0;
+
+  if (this->batch == NULL)
+  {
+    return 0;
+  }
+
+  identify(camera_config, fb, this->batch);
+  this->resultCount = decode(this->batch);
+
+  return this->resultCount;
+}
+
+int ESP32QRCodeReader::identify(camera_config_t* camera_config, camera_fb_t *fb, QRCodeBatch *batch)
+{
+  batch->codeCount = 0;
+  batch->resultCount = 0;
+
+  if (this->q == NULL)
+  {
+    return 0;
+  }
+
+  if (camera_config->frame_size > FRAMESIZE_SVGA)
+  {
+    Serial.println("Camera Size err");
+    return 0;
+  }
 
   if (old_width != fb->width || old_height != fb->height)
   {
@@ -31,49 +250,134 @@ bool ESP32QRCodeReader::qrCodeDetectTask(camera_config_t* camera_config, camera_
     if (quirc_resize(this->q, fb->width, fb->height) < 0)
     {
       //Serial.println("Resize the QR-code recognizer err (cannot allocate memory).");
-      return false;
+      return 0;
     }
     else
     {
       //Serial.println("Resize the QR-code success");
       this->old_width = fb->width;
       this->old_height = fb->height;
+      this->tracking = false;
     }
   }
 
-  image = quirc_begin(this->q, NULL, NULL);
-  memcpy(image, fb->buf, fb->len);
+  // Scan the frame where it is, quirc only reads from it.
+  quirc_begin_external(this->q, fb->buf, fb->width);
+  if (this->tracking)
+  {
+    quirc_set_region(this->q, this->trackBox[0], this->trackBox[1],
+                     this->trackBox[2] - this->trackBox[0], this->trackBox[3] - this->trackBox[1]);
+  }
   quirc_end(this->q);
 
-  int count = quirc_count(this->q);
-  if (count == 0)
+  int grids = quirc_count(this->q);
+  int count = 0;
+
+  // Bounding box of the codes seen in this frame. Tracking follows every
+  // grid whose format information reads, as whether it decodes is only
+  // known later.
+  int box[4] = {(int) fb->width, (int) fb->height, 0, 0};
+
+  for (int i = 0; i < grids && count < QR_CODE_MAX_RESULTS; i++)
   {
-    //Serial.printf("Error: not a valid qrcode\n");
-    return false;
+    // A grid whose format and version information read as garbage is
+    // most often a false match: not worth sampling every cell of.
+    if (quirc_check(this->q, i) != QUIRC_SUCCESS)
+    {
+      continue;
+    }
+
+    quirc_extract(this->q, i, &batch->codes[count]);
+    addToBox(box, &batch->codes[count]);
+    count++;
   }
+  batch->codeCount = count;
 
-  struct quirc_code code;
-  struct quirc_data data;
+  updateTracking(count > 0, box);
+
+  return count;
+}
+
+int ESP32QRCodeReader::decode(QRCodeBatch *batch)
+{
   quirc_decode_error_t err;
+  uint32_t now = millis();
 
-  quirc_extract(this->q, 0, &code);
-  err = quirc_decode(&code, &data);
+  batch->resultCount = 0;
 
-  if (err)
+  if (this->decoder == NULL)
   {
-    const char *error = quirc_strerror(err);
-    //Serial.printf("Decoding FAILED: %s\n", error);
-    return false;
+    return 0;
   }
 
-  //Serial.printf("Decoding successful:\n");
-
-  for (int i = 0; i < data.payload_len; i++)
+  for (int i = 0; i < batch->codeCount; i++)
   {
-    this->buffer[i] = data.payload[i];
+    const struct quirc_code *code = &batch->codes[i];
+    QRCodeResult *result = &batch->results[batch->resultCount];
+    QRCodeCacheEntry *entry = NULL;
+    uint32_t bitmapHash = 0;
+    int x = 0;
+    int y = 0;
+
+    if (this->cacheTtl)
+    {
+      for (int j = 0; j < 4; j++)
+      {
+        x += code->corners[j].x;
+        y += code->corners[j].y;
+      }
+      x /= 4;
+      y /= 4;
+
+      // Same cells in about the same place: nothing new to decode.
+      bitmapHash = hashBytes(code->cell_bitmap, (code->size * code->size + 7) / 8);
+      entry = findCached(bitmapHash, false, x, y, now);
+      if (entry)
+      {
+        entry->lastSeen = now;
+        continue;
+      }
+    }
+
+    // Straight into the result, a segment at a time: no quirc_data.
+    PayloadWriter writer = {result, hashBytes(NULL, 0)};
+
+    result->payloadLen = 0;
+    result->truncated = false;
+    err = quirc_decode_segments(this->decoder, code, writeSegment, &writer);
+    result->payload[min(result->payloadLen, QR_CODE_MAX_PAYLOAD - 1)] = '\0';
+
+    if (err)
+    {
+      const char *error = quirc_strerror(err);
+      //Serial.printf("Decoding FAILED: %s\n", error);
+      continue;
+    }
+
+    if (this->cacheTtl)
+    {
+      uint32_t payloadHash = writer.hash;
+
+      // Read differently this time, but still the same code.
+      entry = findCached(payloadHash, true, x, y, now);
+      if (entry)
+      {
+        entry->bitmapHash = bitmapHash;
+        entry->lastSeen = now;
+        continue;
+      }
+
+      remember(payloadHash, bitmapHash, x, y, now);
+    }
+
+    for (int j = 0; j < 4; j++)
+    {
+      result->corners[j] = code->corners[j];
+    }
+    batch->resultCount++;
   }
 
-  this->buffer[data.payload_len] = '\0';
+  //Serial.printf("Decoding successful:\n");
 
-  return true;
+  return batch->resultCount;
 }
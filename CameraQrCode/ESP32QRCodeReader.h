@@ -1,9 +1,49 @@
 #ifndef ESP32_QR_CODE_ARDUINO_H_
 #define ESP32_QR_CODE_ARDUINO_H_
 
+#include <stdlib.h>
 #include "quirc.h"
 #include "esp_camera.h"
 
+// Most codes decoded from one frame (QUIRC_MAX_GRIDS).
+#define QR_CODE_MAX_RESULTS 8
+
+// Longest payload kept of a code, nul terminator included: as much as
+// fits in one line to the serial host. quirc_data would hold 8896 bytes.
+#define QR_CODE_MAX_PAYLOAD 1024
+
+// One code decoded from a frame. payload holds its payload (nul
+// terminated), cut short if truncated is set; payloadLen is its full
+// length either way. corners give its location in the frame.
+struct QRCodeResult
+{
+  struct quirc_point corners[4];
+  int payloadLen;
+  bool truncated;
+  uint8_t payload[QR_CODE_MAX_PAYLOAD];
+};
+
+// The codes found in one frame and, once they have been decoded, the
+// new ones among them. Handed from stage to stage by a QRPipeline.
+struct QRCodeBatch
+{
+  int codeCount;
+  struct quirc_code codes[QR_CODE_MAX_RESULTS];
+  int resultCount;
+  QRCodeResult results[QR_CODE_MAX_RESULTS];
+  uint32_t started;  // micros() when the frame was taken, for latency
+};
+
+// A code reported recently, remembered by the duplicate filter.
+struct QRCodeCacheEntry
+{
+  uint32_t payloadHash;
+  uint32_t bitmapHash;
+  int centerX;
+  int centerY;
+  uint32_t lastSeen;
+};
+
 class ESP32QRCodeReader
 {
 public:
@@ -12,14 +52,70 @@ public:
   ESP32QRCodeReader();
   ~ESP32QRCodeReader() { 
     quirc_destroy(this->q);
+    quirc_decoder_destroy(this->decoder);
+    free(this->batch);
   }
 
-  uint8_t buffer[1024];
+  uint8_t buffer[QR_CODE_MAX_PAYLOAD];
+  // Set when the payload in buffer was too long to keep whole.
+  bool truncated = false;
 
   bool qrCodeDetectTask(camera_config_t* camera_config, camera_fb_t *fb);
 
+  // Decodes every code found in the frame into results[], returning how
+  // many there are. They stay valid until the next call.
+  int qrCodeDetectAll(camera_config_t* camera_config, camera_fb_t *fb);
+
+  QRCodeResult *results = NULL;
+  int resultCount = 0;
+
+  // The two halves of qrCodeDetectAll(), so that they can run on
+  // different tasks. identify() finds the codes in the frame and
+  // extracts their cells into the batch, after which the frame is no
+  // longer needed. decode() fills in the batch's results. Each must
+  // always be called from the same task.
+  int identify(camera_config_t* camera_config, camera_fb_t *fb, QRCodeBatch *batch);
+  int decode(QRCodeBatch *batch);
+
+  // Leave out codes reported in the last ttlMs milliseconds that have
+  // moved by no more than moveTolerance pixels. Such codes are not even
+  // decoded when their cells read the same as last time. A ttlMs of 0
+  // (the default) reports every code in every frame.
+  void setDuplicateFilter(uint32_t ttlMs, int moveTolerance);
+
+  // Once a code has been found, scan only the area around it, grown by
+  // marginPercent of its size on each side, until maxMisses frames in a
+  // row come up empty; then go back to whole frames. A maxMisses of 0
+  // (the default) always scans the whole frame.
+  void setTracking(int marginPercent, int maxMisses);
+
+  // Split the work on each frame between this many threads, the
+  // calling task's included; on the ESP32 the others run on the other
+  // core at the caller's priority. Call it from the task which runs the
+  // detector. Returns false if a thread could not be started.
+  bool setThreads(int threads);
+
 private:
+  QRCodeCacheEntry *findCached(uint32_t hash, bool payload, int x, int y, uint32_t now);
+  void remember(uint32_t payloadHash, uint32_t bitmapHash, int x, int y, uint32_t now);
+  void updateTracking(bool seen, const int box[4]);
+
+  QRCodeCacheEntry cache[QR_CODE_MAX_RESULTS];
+  int cacheCount = 0;
+  uint32_t cacheTtl = 0;
+  int cacheTolerance = 0;
+
+  // Region scanned while tracking: left, top, right, bottom
+  int trackBox[4];
+  int trackMargin = 50;
+  int trackMaxMisses = 0;
+  int trackMisses = 0;
+  bool tracking = false;
+
+  QRCodeBatch *batch = NULL;
   struct quirc *q = NULL;
+  // Scratch space of decode(), kept from one frame to the next
+  struct quirc_decoder *decoder = NULL;
   uint16_t old_width = 0;
   uint16_t old_height = 0;
 
@@ -0,0 +1,78 @@
+#include "FramePool.h"
+#include "Arduino.h"
+
+FramePool::FramePool(int slots)
+{
+  memset(&this->stats, 0, sizeof(this->stats));
+  this->pending = xQueueCreate(slots, sizeof(camera_fb_t*));
+  this->free_slots = xSemaphoreCreateCounting(slots, slots);
+  if (this->pending == NULL || this->free_slots == NULL)
+  {
+      Serial.println("can't create frame pool");
+  }
+}
+
+FramePool::~FramePool()
+{
+  camera_fb_t *fb = NULL;
+
+  if (this->pending != NULL)
+  {
+    while (xQueueReceive(this->pending, &fb, 0))
+    {
+      esp_camera_fb_return(fb);
+    }
+    vQueueDelete(this->pending);
+  }
+  if (this->free_slots != NULL)
+  {
+    vSemaphoreDelete(this->free_slots);
+  }
+}
+
+void FramePool::put(camera_fb_t *fb)
+{
+  camera_fb_t *oldest = NULL;
+
+  if (this->pending == NULL || this->free_slots == NULL)
+  {
+    esp_camera_fb_return(fb);
+    return;
+  }
+
+  if (!xSemaphoreTake(this->free_slots, 0))
+  {
+    // No free slot: reuse the one of the oldest frame still waiting,
+    // unless the detector is busy with all of them.
+    if (!xQueueReceive(this->pending, &oldest, 0))
+    {
+      this->stats.exhausted++;
+      esp_camera_fb_return(fb);
+      return;
+    }
+    this->stats.dropped++;
+    esp_camera_fb_return(oldest);
+  }
+
+  // A slot is held, so the queue has room.
+  xQueueSend(this->pending, &fb, 0);
+  this->stats.queued++;
+}
+
+camera_fb_t *FramePool::get(TickType_t timeout)
+{
+  camera_fb_t *fb = NULL;
+
+  if (this->pending == NULL || !xQueueReceive(this->pending, &fb, timeout))
+  {
+    return NULL;
+  }
+  return fb;
+}
+
+void FramePool::release(camera_fb_t *fb)
+{
+  esp_camera_fb_return(fb);
+  this->stats.scanned++;
+  xSemaphoreGive(this->free_slots);
+}
@@ -0,0 +1,51 @@
+#ifndef FRAME_POOL_H_
+#define FRAME_POOL_H_
+
+#include "esp_camera.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+// Counters since the pool was created. Each one is only ever written by
+// a single task, so they can be read at any time without locking.
+struct FramePoolStats
+{
+  uint32_t queued;     // frames handed to the detector
+  uint32_t scanned;    // frames the detector has finished with
+  uint32_t dropped;    // queued frames replaced by a newer one unscanned
+  uint32_t exhausted;  // frames refused because the detector held every slot
+};
+
+// Hands camera frames from the stream handler to the detector task.
+//
+// The pool lends up to `slots` of the camera driver's frame buffers to
+// the detector, so fb_count must be at least slots + 1 for the stream to
+// keep a buffer of its own. Nothing is allocated per frame: the free
+// list is a counting semaphore and the pending frames sit in a queue,
+// both created up front. When the detector falls behind, the oldest
+// pending frame goes back to the camera in favour of the new one.
+class FramePool
+{
+public:
+
+  FramePool(int slots);
+  ~FramePool();
+
+  // Stream side. Takes ownership of fb, which is either queued for the
+  // detector or returned to the camera driver straight away.
+  void put(camera_fb_t *fb);
+
+  // Detector side. Waits up to `timeout` for the next frame; each frame
+  // obtained must be given back with release() once scanned.
+  camera_fb_t *get(TickType_t timeout);
+  void release(camera_fb_t *fb);
+
+  FramePoolStats stats;
+
+private:
+  QueueHandle_t pending = NULL;
+  SemaphoreHandle_t free_slots = NULL;
+
+};
+
+#endif // FRAME_POOL_H_
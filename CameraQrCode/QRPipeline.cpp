@@ -0,0 +1,167 @@
+#include "QRPipeline.h"
+#include "Arduino.h"
+
+// Folds a sample into a moving average, 1/16 of the way.
+static uint32_t average(uint32_t avg, uint32_t sample)
+{
+  return avg + ((int32_t)(sample - avg) >> 4);
+}
+
+static void record(QRPipelineStageStats *stats, uint32_t busy, uint32_t wait, uint32_t blocked)
+{
+  stats->avgUs = average(stats->avgUs, busy);
+  stats->waitUs = average(stats->waitUs, wait);
+  stats->blockedUs = average(stats->blockedUs, blocked);
+  if (busy > stats->maxUs)
+  {
+    stats->maxUs = busy;
+  }
+  stats->frames++;
+}
+
+// Frames queued in front of a stage as it takes the next one
+static void recordDepth(QRPipelineStageStats *stats, QueueHandle_t queue)
+{
+  uint32_t depth = uxQueueMessagesWaiting(queue) + 1;
+
+  if (depth > stats->maxDepth)
+  {
+    stats->maxDepth = depth;
+  }
+}
+
+QRPipeline::QRPipeline(ESP32QRCodeReader *reader, FramePool *frames, camera_config_t *config,
+                       void (*emit)(const QRCodeResult *results, int count))
+{
+  memset(&this->stats, 0, sizeof(this->stats));
+  this->reader = reader;
+  this->frames = frames;
+  this->config = config;
+  this->emit = emit;
+
+  this->batches = (QRCodeBatch*) ps_malloc(sizeof(QRCodeBatch) * QR_PIPELINE_BATCHES);
+  this->freeBatches = xQueueCreate(QR_PIPELINE_BATCHES, sizeof(QRCodeBatch*));
+  this->identified = xQueueCreate(QR_PIPELINE_BATCHES, sizeof(QRCodeBatch*));
+  this->decoded = xQueueCreate(QR_PIPELINE_BATCHES, sizeof(QRCodeBatch*));
+  if (this->batches == NULL || this->freeBatches == NULL || this->identified == NULL || this->decoded == NULL)
+  {
+      Serial.println("can't create QR pipeline");
+      return;
+  }
+
+  for (int i = 0; i < QR_PIPELINE_BATCHES; i++)
+  {
+    QRCodeBatch *batch = &this->batches[i];
+    xQueueSend(this->freeBatches, &batch, 0);
+  }
+}
+
+bool QRPipeline::start(int identifyCore, int threads)
+{
+  if (this->batches == NULL || this->freeBatches == NULL || this->identified == NULL || this->decoded == NULL)
+  {
+    return false;
+  }
+
+  this->threads = threads;
+
+  // Decoding works in the reader's quirc_decoder, not on the stack.
+  return xTaskCreatePinnedToCore(identifyTask, "qrIdentifyTask", 16 * 1024, this, 5, NULL, identifyCore) == pdPASS &&
+         xTaskCreatePinnedToCore(decodeTask, "qrDecodeTask", 16 * 1024, this, 5, NULL, 1 - identifyCore) == pdPASS &&
+         xTaskCreatePinnedToCore(emitTask, "qrEmitTask", 8 * 1024, this, 5, NULL, 1 - identifyCore) == pdPASS;
+}
+
+int QRPipeline::decodeDepth()
+{
+  return this->identified ? uxQueueMessagesWaiting(this->identified) : 0;
+}
+
+int QRPipeline::emitDepth()
+{
+  return this->decoded ? uxQueueMessagesWaiting(this->decoded) : 0;
+}
+
+void QRPipeline::identifyTask(void *arg)
+{
+  QRPipeline *pipeline = (QRPipeline*) arg;
+  QRCodeBatch *batch = NULL;
+  camera_fb_t *fb = NULL;
+
+  // Helper threads go to the other cores from here.
+  if (!pipeline->reader->setThreads(pipeline->threads))
+  {
+    Serial.println("can't start detector threads");
+  }
+
+  while (true)
+  {
+    uint32_t start = micros();
+    xQueueReceive(pipeline->freeBatches, &batch, portMAX_DELAY);
+
+    uint32_t gotBatch = micros();
+    do
+    {
+      fb = pipeline->frames->get((TickType_t)pdMS_TO_TICKS(100));
+    } while (fb == NULL);
+
+    uint32_t gotFrame = micros();
+    batch->started = gotFrame;
+    pipeline->reader->identify(pipeline->config, fb, batch);
+    pipeline->frames->release(fb);
+    fb = NULL;
+
+    uint32_t done = micros();
+    xQueueSend(pipeline->identified, &batch, portMAX_DELAY);
+    record(&pipeline->stats.identify, done - gotFrame, gotFrame - gotBatch, gotBatch - start);
+  }
+}
+
+void QRPipeline::decodeTask(void *arg)
+{
+  QRPipeline *pipeline = (QRPipeline*) arg;
+  QRCodeBatch *batch = NULL;
+
+  while (true)
+  {
+    uint32_t start = micros();
+    xQueueReceive(pipeline->identified, &batch, portMAX_DELAY);
+    recordDepth(&pipeline->stats.decode, pipeline->identified);
+
+    uint32_t gotBatch = micros();
+    pipeline->reader->decode(batch);
+
+    // There is always room: no more batches exist than a queue holds.
+    uint32_t done = micros();
+    xQueueSend(pipeline->decoded, &batch, portMAX_DELAY);
+    record(&pipeline->stats.decode, done - gotBatch, gotBatch - start, 0);
+  }
+}
+
+void QRPipeline::emitTask(void *arg)
+{
+  QRPipeline *pipeline = (QRPipeline*) arg;
+  QRCodeBatch *batch = NULL;
+
+  while (true)
+  {
+    uint32_t start = micros();
+    xQueueReceive(pipeline->decoded, &batch, portMAX_DELAY);
+    recordDepth(&pipeline->stats.emit, pipeline->decoded);
+
+    uint32_t gotBatch = micros();
+    if (batch->resultCount > 0)
+    {
+      pipeline->emit(batch->results, batch->resultCount);
+    }
+
+    uint32_t done = micros();
+    pipeline->stats.latencyUs = done - batch->started;
+    if (pipeline->stats.latencyUs > pipeline->stats.maxLatencyUs)
+    {
+      pipeline->stats.maxLatencyUs = pipeline->stats.latencyUs;
+    }
+
+    xQueueSend(pipeline->freeBatches, &batch, portMAX_DELAY);
+    record(&pipeline->stats.emit, done - gotBatch, gotBatch - start, 0);
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef QR_PIPELINE_H_
+#define QR_PIPELINE_H_
+
+#include "ESP32QRCodeReader.h"
+#include "FramePool.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+// Batches in flight: one per stage, so that every stage can be busy.
+#define QR_PIPELINE_BATCHES 3
+
+// Counters of one stage since the pipeline started. Each is only ever
+// written by the stage's own task, so they can be read at any time
+// without locking. Averages move by 1/16 of the difference per frame.
+struct QRPipelineStageStats
+{
+  uint32_t frames;     // frames the stage has finished
+  uint32_t avgUs;      // time spent working on a frame
+  uint32_t maxUs;      // longest time spent working on a frame
+  uint32_t waitUs;     // time per frame spent waiting for input
+  uint32_t blockedUs;  // time per frame spent waiting for a free batch
+  uint32_t maxDepth;   // most frames seen queued in front of the stage
+};
+
+struct QRPipelineStats
+{
+  QRPipelineStageStats identify;  // frames in front of it: see FramePool
+  QRPipelineStageStats decode;
+  QRPipelineStageStats emit;
+  uint32_t latencyUs;     // frame taken from the pool to results emitted
+  uint32_t maxLatencyUs;
+};
+
+// Runs the QR program as three tasks connected by bounded queues:
+// identification (quirc_end() and grid extraction) on one core, then
+// decoding and result emission on the other, so that frame N is decoded
+// while frame N + 1 is identified. Each batch of codes travels through
+// all three stages and back to the free list; with every batch taken,
+// identification waits and frames pile up in the frame pool instead.
+class QRPipeline
+{
+public:
+
+  // emit is called from the emission task with the new codes of each
+  // frame that has any.
+  QRPipeline(ESP32QRCodeReader *reader, FramePool *frames, camera_config_t *config,
+             void (*emit)(const QRCodeResult *results, int count));
+
+  // Starts the tasks: identification on identifyCore, using the given
+  // number of detector threads, the other two stages on the other core.
+  bool start(int identifyCore, int threads);
+
+  // Frames waiting in front of the decode and emission stages right now
+  int decodeDepth();
+  int emitDepth();
+
+  QRPipelineStats stats;
+
+private:
+  static void identifyTask(void *arg);
+  static void decodeTask(void *arg);
+  static void emitTask(void *arg);
+
+  ESP32QRCodeReader *reader;
+  FramePool *frames;
+  camera_config_t *config;
+  void (*emit)(const QRCodeResult *results, int count);
+  int threads = 1;
+
+  QRCodeBatch *batches = NULL;
+  QueueHandle_t freeBatches = NULL;
+  QueueHandle_t identified = NULL;
+  QueueHandle_t decoded = NULL;
+
+};
+
+#endif // QR_PIPELINE_H_
@@ -17,6 +17,7 @@
 #include "esp_camera.h"
 #include "img_converters.h"
 #include "Arduino.h"
+#include "FramePool.h"
 
 #include "fb_gfx.h"
 #include "fd_forward.h"
@@ -36,7 +37,7 @@ static const char* _STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %
 
 httpd_handle_t stream_httpd = NULL;
 httpd_handle_t camera_httpd = NULL;
-QueueHandle_t qrCodeQueue = NULL;
+FramePool *framePool = NULL;
 
 static esp_err_t capture_handler(httpd_req_t *req) {
   camera_fb_t * fb = NULL;
@@ -90,23 +91,15 @@ static esp_err_t stream_handler(httpd_req_t *req) {
       res = ESP_FAIL;
     } else {
       if (fb->format != PIXFORMAT_JPEG) {
-        if (qrCodeQueue) {
-          camera_fb_t *fb_to_send = (camera_fb_t*) ps_malloc(sizeof(camera_fb_t));
-          fb_to_send->width = fb->width;
-          fb_to_send->height = fb->height;
-          fb_to_send->format = fb->format;
-          fb_to_send->len = fb->len;
-          fb_to_send->buf = (uint8_t*) ps_malloc(sizeof(uint8_t) * fb_to_send->len);
-          memcpy(fb_to_send->buf, fb->buf, fb_to_send->len);
-          if (!xQueueSend(qrCodeQueue, &fb_to_send, (TickType_t)0))
-          {
-            free(fb_to_send->buf);
-            free(fb_to_send);
-          }
-        }
-
         bool jpeg_converted = frame2jpg(fb, 80, &_jpg_buf, &_jpg_buf_len);
-        esp_camera_fb_return(fb);
+
+        // Hand the camera frame itself to the detector, which returns it
+        // to the driver once scanned.
+        if (framePool) {
+          framePool->put(fb);
+        } else {
+          esp_camera_fb_return(fb);
+        }
         fb = NULL;
         if (!jpeg_converted) {
           //Serial.println("JPEG compression failed");
@@ -145,8 +138,8 @@ static esp_err_t stream_handler(httpd_req_t *req) {
   return res;
 }
 
-void startCameraServer(QueueHandle_t codeQueue) {
-  qrCodeQueue = codeQueue;
+void startCameraServer(FramePool *pool) {
+  framePool = pool;
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
 
   httpd_uri_t capture_uri = {
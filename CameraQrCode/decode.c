@@ -45,7 +45,10 @@ static const struct galois_field gf16 = {
     .log = gf16_log,
     .exp = gf16_exp};
 
-static const uint8_t gf256_exp[256] = {
+/* Two periods, so that the sum of two logarithms can index it without
+ * being reduced modulo 255 first.
+ */
+static const uint8_t gf256_exp[512] = {
     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
     0x1d, 0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26,
     0x4c, 0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9,
@@ -77,7 +80,39 @@ static const uint8_t gf256_exp[256] = {
     0x12, 0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5,
     0xf7, 0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16,
     0x2c, 0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83,
-    0x1b, 0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01};
+    0x1b, 0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01,
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d,
+    0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26, 0x4c,
+    0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9, 0x8f,
+    0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0, 0x9d,
+    0x27, 0x4e, 0x9c, 0x25, 0x4a, 0x94, 0x35, 0x6a,
+    0xd4, 0xb5, 0x77, 0xee, 0xc1, 0x9f, 0x23, 0x46,
+    0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d,
+    0xba, 0x69, 0xd2, 0xb9, 0x6f, 0xde, 0xa1, 0x5f,
+    0xbe, 0x61, 0xc2, 0x99, 0x2f, 0x5e, 0xbc, 0x65,
+    0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0, 0xfd,
+    0xe7, 0xd3, 0xbb, 0x6b, 0xd6, 0xb1, 0x7f, 0xfe,
+    0xe1, 0xdf, 0xa3, 0x5b, 0xb6, 0x71, 0xe2, 0xd9,
+    0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d,
+    0x1a, 0x34, 0x68, 0xd0, 0xbd, 0x67, 0xce, 0x81,
+    0x1f, 0x3e, 0x7c, 0xf8, 0xed, 0xc7, 0x93, 0x3b,
+    0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc, 0x85,
+    0x17, 0x2e, 0x5c, 0xb8, 0x6d, 0xda, 0xa9, 0x4f,
+    0x9e, 0x21, 0x42, 0x84, 0x15, 0x2a, 0x54, 0xa8,
+    0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49,
+    0x92, 0x39, 0x72, 0xe4, 0xd5, 0xb7, 0x73, 0xe6,
+    0xd1, 0xbf, 0x63, 0xc6, 0x91, 0x3f, 0x7e, 0xfc,
+    0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff, 0xe3,
+    0xdb, 0xab, 0x4b, 0x96, 0x31, 0x62, 0xc4, 0x95,
+    0x37, 0x6e, 0xdc, 0xa5, 0x57, 0xae, 0x41, 0x82,
+    0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c,
+    0x38, 0x70, 0xe0, 0xdd, 0xa7, 0x53, 0xa6, 0x51,
+    0xa2, 0x59, 0xb2, 0x79, 0xf2, 0xf9, 0xef, 0xc3,
+    0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09, 0x12,
+    0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5, 0xf7,
+    0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16, 0x2c,
+    0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b,
+    0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01, 0x02};
 
 static const uint8_t gf256_log[256] = {
     0x00, 0xff, 0x01, 0x19, 0x02, 0x32, 0x1a, 0xc6,
@@ -237,36 +272,53 @@ static void berlekamp_massey(const uint8_t *s, int N,
  * Generator polynomial for GF(2^8) is x^8 + x^4 + x^3 + x^2 + 1
  */
 
+/* Syndrome i is the block, read as a polynomial with data[0] as its
+ * highest coefficient, evaluated at alpha^i. Horner's rule takes each
+ * byte in turn: multiplying by alpha^i only adds i to a logarithm.
+ */
 static int block_syndromes(const uint8_t *data, int bs, int npar, uint8_t *s)
 {
   int nonzero = 0;
   int i;
+  int j;
 
   memset(s, 0, MAX_POLY);
 
-  for (i = 0; i < npar; i++)
+  for (j = 0; j < bs; j++)
   {
-    int j;
+    const uint8_t c = data[j];
 
-    for (j = 0; j < bs; j++)
+    for (i = 0; i < npar; i++)
     {
-      uint8_t c = data[bs - j - 1];
-
-      if (!c)
-        continue;
+      const uint8_t x = s[i];
 
-      s[i] ^= gf256_exp[((int)gf256_log[c] +
-                         i * j) %
-                        255];
+      s[i] = (x ? gf256_exp[gf256_log[x] + i] : 0) ^ c;
     }
-
-    if (s[i])
-      nonzero = 1;
   }
 
+  for (i = 0; i < npar; i++)
+    nonzero |= s[i];
+
   return nonzero;
 }
 
+/* Takes an error of the given magnitude at the given power of x out of
+ * the syndromes, as correcting it in the block would.
+ */
+static void cancel_syndromes(uint8_t *s, int npar, uint8_t error, int pos)
+{
+  int log_e = gf256_log[error];
+  int i;
+
+  for (i = 0; i < npar; i++)
+  {
+    s[i] ^= gf256_exp[log_e];
+    log_e += pos;
+    if (log_e >= 255)
+      log_e -= 255;
+  }
+}
+
 static void eloc_poly(uint8_t *omega,
                       const uint8_t *s, const uint8_t *sigma,
                       int npar)
@@ -308,7 +360,13 @@ static quirc_decode_error_t correct_block(uint8_t *data,
   uint8_t sigma[MAX_POLY];
   uint8_t sigma_deriv[MAX_POLY];
   uint8_t omega[MAX_POLY];
+  int term_log[MAX_POLY];
+  int term_step[MAX_POLY];
+  int terms = 0;
+  int found = 0;
+  int deg;
   int i;
+  int k;
 
   /* Compute syndrome vector */
   if (!block_syndromes(data, ecc->bs, npar, s))
@@ -324,13 +382,39 @@ static quirc_decode_error_t correct_block(uint8_t *data,
   /* Compute error evaluator polynomial */
   eloc_poly(omega, s, sigma, npar - 1);
 
+  /* A locator of degree deg has at most deg roots */
+  for (deg = MAX_POLY - 1; deg > 0 && !sigma[deg]; deg--)
+    ;
+
+  /* Chien search: term k of sigma(alpha^-i) is sigma[k] * alpha^-ik,
+   * kept as a logarithm that steps down by k with each position.
+   */
+  for (k = 1; k <= deg; k++)
+  {
+    if (!sigma[k])
+      continue;
+
+    term_log[terms] = gf256_log[sigma[k]];
+    term_step[terms] = 255 - k;
+    terms++;
+  }
+
   /* Find error locations and magnitudes */
-  for (i = 0; i < ecc->bs; i++)
+  for (i = 0; i < ecc->bs && found < deg; i++)
   {
-    uint8_t xinv = gf256_exp[255 - i];
+    uint8_t sum = sigma[0];
 
-    if (!poly_eval(sigma, xinv, &gf256))
+    for (k = 0; k < terms; k++)
     {
+      sum ^= gf256_exp[term_log[k]];
+      term_log[k] += term_step[k];
+      if (term_log[k] >= 255)
+        term_log[k] -= 255;
+    }
+
+    if (!sum)
+    {
+      uint8_t xinv = gf256_exp[255 - i];
       uint8_t sd_x = poly_eval(sigma_deriv, xinv, &gf256);
       uint8_t omega_x = poly_eval(omega, xinv, &gf256);
       uint8_t error = gf256_exp[(255 - gf256_log[sd_x] +
@@ -338,11 +422,15 @@ static quirc_decode_error_t correct_block(uint8_t *data,
                                 255];
 
       data[ecc->bs - i - 1] ^= error;
+      cancel_syndromes(s, npar, error, i);
+      found++;
     }
   }
 
-  if (block_syndromes(data, ecc->bs, npar, s))
-    return QUIRC_ERROR_DATA_ECC;
+  /* Whatever the corrections left over is an error they missed */
+  for (i = 0; i < npar; i++)
+    if (s[i])
+      return QUIRC_ERROR_DATA_ECC;
 
   return QUIRC_SUCCESS;
 }
@@ -407,6 +495,37 @@ static quirc_decode_error_t correct_format(uint16_t *f_ret)
   return QUIRC_SUCCESS;
 }
 
+/************************************************************************
+ * Version information check
+ *
+ * Generator polynomial for the BCH(18, 6) code is
+ * x^12 + x^11 + x^10 + x^9 + x^8 + x^5 + x^2 + 1
+ */
+
+#define VERSION_MAX_ERROR 3
+#define VERSION_POLY 0x1f25
+
+/* Whether the version information read is within correction of the
+ * codeword for the given version.
+ */
+static int version_matches(int version, uint32_t bits)
+{
+  uint32_t word = (uint32_t)version << 12;
+  uint32_t diff;
+  int errors = 0;
+  int i;
+
+  for (i = 17; i >= 12; i--)
+    if (word & (1u << i))
+      word ^= (uint32_t)VERSION_POLY << (i - 12);
+
+  diff = bits ^ (((uint32_t)version << 12) | word);
+  for (; diff; diff &= diff - 1)
+    errors++;
+
+  return errors <= VERSION_MAX_ERROR;
+}
+
 /************************************************************************
  * Decoder algorithm
  */
@@ -418,6 +537,26 @@ struct datastream
   int ptr;
 
   uint8_t data[QUIRC_MAX_PAYLOAD];
+
+  /* The grid unmasked, and its cells which hold no data */
+  uint8_t cells[QUIRC_MAX_BITMAP];
+  uint8_t reserved[QUIRC_MAX_BITMAP];
+
+  /* What the format information says */
+  int version;
+  int ecc_level;
+  int mask;
+
+  /* The payload goes to out: a quirc_data's payload, or when streaming
+   * the raw stream's space, no longer needed by then, one segment at a
+   * time which is handed to fn.
+   */
+  uint8_t *out;
+  int out_len;
+  int data_type;
+  uint32_t eci;
+  quirc_segment_fn fn;
+  void *arg;
 } __attribute__((aligned(8)));
 
 static inline int grid_bit(const struct quirc_code *code, int x, int y)
@@ -427,22 +566,24 @@ static inline int grid_bit(const struct quirc_code *code, int x, int y)
   return (code->cell_bitmap[p >> 3] >> (p & 7)) & 1;
 }
 
-static quirc_decode_error_t read_format(const struct quirc_code *code,
-                                        struct quirc_data *data, int which)
+static int code_cell(void *arg, int x, int y)
+{
+  return grid_bit((const struct quirc_code *)arg, x, y);
+}
+
+/* The 15 bits of one copy of the format information, still masked */
+static uint16_t format_bits(int size, int which, quirc_cell_fn cell,
+                            void *arg)
 {
-  int i;
   uint16_t format = 0;
-  uint16_t fdata;
-  quirc_decode_error_t err;
+  int i;
 
   if (which)
   {
     for (i = 0; i < 7; i++)
-      format = (format << 1) |
-               grid_bit(code, 8, code->size - 1 - i);
+      format = (format << 1) | cell(arg, 8, size - 1 - i);
     for (i = 0; i < 8; i++)
-      format = (format << 1) |
-               grid_bit(code, code->size - 8 + i, 8);
+      format = (format << 1) | cell(arg, size - 8 + i, 8);
   }
   else
   {
@@ -452,9 +593,41 @@ static quirc_decode_error_t read_format(const struct quirc_code *code,
         0, 1, 2, 3, 4, 5, 7, 8, 8, 8, 8, 8, 8, 8, 8};
 
     for (i = 14; i >= 0; i--)
-      format = (format << 1) | grid_bit(code, xs[i], ys[i]);
+      format = (format << 1) | cell(arg, xs[i], ys[i]);
+  }
+
+  return format;
+}
+
+/* The 18 bits of one copy of the version information, beside the top
+ * right finder or the bottom left one.
+ */
+static uint32_t version_bits(int size, int which, quirc_cell_fn cell,
+                             void *arg)
+{
+  uint32_t bits = 0;
+  int i;
+
+  for (i = 0; i < 18; i++)
+  {
+    int across = size - 11 + i % 3;
+    int down = i / 3;
+
+    if (which ? cell(arg, down, across) : cell(arg, across, down))
+      bits |= 1u << i;
   }
 
+  return bits;
+}
+
+static quirc_decode_error_t read_format(const struct quirc_code *code,
+                                        struct datastream *ds, int which)
+{
+  uint16_t format;
+  uint16_t fdata;
+  quirc_decode_error_t err;
+
+  format = format_bits(code->size, which, code_cell, (void *)code);
   format ^= 0x5412;
 
   err = correct_format(&format);
@@ -462,131 +635,132 @@ static quirc_decode_error_t read_format(const struct quirc_code *code,
     return err;
 
   fdata = format >> 10;
-  data->ecc_level = fdata >> 3;
-  data->mask = fdata & 7;
+  ds->ecc_level = fdata >> 3;
+  ds->mask = fdata & 7;
 
   return QUIRC_SUCCESS;
 }
 
-static int mask_bit(int mask, int i, int j)
+quirc_decode_error_t quirc_check_info(int size, quirc_cell_fn cell, void *arg)
 {
-  switch (mask)
+  int version = (size - 17) / 4;
+  uint16_t format;
+
+  if ((size - 17) % 4)
+    return QUIRC_ERROR_INVALID_GRID_SIZE;
+  if (version < 1 || version > QUIRC_MAX_VERSION)
+    return QUIRC_ERROR_INVALID_VERSION;
+
+  format = format_bits(size, 0, cell, arg) ^ 0x5412;
+  if (correct_format(&format))
   {
-  case 0:
-    return !((i + j) % 2);
-  case 1:
-    return !(i % 2);
-  case 2:
-    return !(j % 3);
-  case 3:
-    return !((i + j) % 3);
-  case 4:
-    return !(((i / 2) + (j / 3)) % 2);
-  case 5:
-    return !((i * j) % 2 + (i * j) % 3);
-  case 6:
-    return !(((i * j) % 2 + (i * j) % 3) % 2);
-  case 7:
-    return !(((i * j) % 3 + (i + j) % 2) % 2);
+    format = format_bits(size, 1, cell, arg) ^ 0x5412;
+    if (correct_format(&format))
+      return QUIRC_ERROR_FORMAT_ECC;
   }
 
-  return 0;
+  if (version >= 7 &&
+      !version_matches(version, version_bits(size, 0, cell, arg)) &&
+      !version_matches(version, version_bits(size, 1, cell, arg)))
+    return QUIRC_ERROR_INVALID_VERSION;
+
+  return QUIRC_SUCCESS;
 }
 
-static int reserved_cell(int version, int i, int j)
+static const uint8_t mask_rows[8][12] = {
+    {0x15, 0x2a, 0x15, 0x2a, 0x15, 0x2a, 0x15, 0x2a, 0x15, 0x2a, 0x15, 0x2a},
+    {0x3f, 0x00, 0x3f, 0x00, 0x3f, 0x00, 0x3f, 0x00, 0x3f, 0x00, 0x3f, 0x00},
+    {0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09},
+    {0x09, 0x24, 0x12, 0x09, 0x24, 0x12, 0x09, 0x24, 0x12, 0x09, 0x24, 0x12},
+    {0x07, 0x07, 0x38, 0x38, 0x07, 0x07, 0x38, 0x38, 0x07, 0x07, 0x38, 0x38},
+    {0x3f, 0x01, 0x09, 0x15, 0x09, 0x01, 0x3f, 0x01, 0x09, 0x15, 0x09, 0x01},
+    {0x3f, 0x07, 0x1b, 0x15, 0x2d, 0x31, 0x3f, 0x07, 0x1b, 0x15, 0x2d, 0x31},
+    {0x15, 0x38, 0x31, 0x2a, 0x07, 0x0e, 0x15, 0x38, 0x31, 0x2a, 0x07, 0x0e}};
+
+/* Copies the grid with the mask taken off it */
+static void unmask_cells(const struct quirc_code *code, int mask,
+                         uint8_t *cells)
 {
-  const struct quirc_version_info *ver = &quirc_version_db[version];
-  int size = version * 4 + 17;
-  int ai = -1, aj = -1, a;
-
-  /* Finder + format: top left */
-  if (i < 9 && j < 9)
-    return 1;
-
-  /* Finder + format: bottom left */
-  if (i + 8 >= size && j < 9)
-    return 1;
-
-  /* Finder + format: top right */
-  if (i < 9 && j + 8 >= size)
-    return 1;
-
-  /* Exclude timing patterns */
-  if (i == 6 || j == 6)
-    return 1;
+  const uint8_t *rows = mask_rows[mask];
+  int p = 0;
+  int i;
 
-  /* Exclude version info, if it exists. Version info sits adjacent to
-     * the top-right and bottom-left finders in three rows, bounded by
-     * the timing pattern.
-     */
-  if (version >= 7)
-  {
-    if (i < 6 && j + 11 >= size)
-      return 1;
-    if (i + 11 >= size && j < 6)
-      return 1;
-  }
+  memcpy(cells, code->cell_bitmap, (code->size * code->size + 7) >> 3);
 
-  /* Exclude alignment patterns */
-  for (a = 0; a < QUIRC_MAX_ALIGNMENT && ver->apat[a]; a++)
+  for (i = 0; i < code->size; i++)
   {
-    int p = ver->apat[a];
+    const int row = rows[i % 12];
+    int j6 = 0;
+    int j;
 
-    if (abs(p - i) < 3)
-      ai = a;
-    if (abs(p - j) < 3)
-      aj = a;
-  }
+    for (j = 0; j < code->size; j++)
+    {
+      if ((row >> j6) & 1)
+        cells[p >> 3] ^= 1 << (p & 7);
 
-  if (ai >= 0 && aj >= 0)
-  {
-    a--;
-    if (ai > 0 && ai < a)
-      return 1;
-    if (aj > 0 && aj < a)
-      return 1;
-    if (aj == a && ai == a)
-      return 1;
+      p++;
+      if (++j6 == 6)
+        j6 = 0;
+    }
   }
-
-  return 0;
 }
 
-static void read_bit(const struct quirc_code *code,
-                     struct quirc_data *data,
-                     struct datastream *ds, int i, int j)
+static inline void read_cell(struct datastream *ds, int p)
 {
-  int bitpos = ds->data_bits & 7;
-  int bytepos = ds->data_bits >> 3;
-  int v = grid_bit(code, j, i);
-
-  if (mask_bit(data->mask, i, j))
-    v ^= 1;
+  if ((ds->reserved[p >> 3] >> (p & 7)) & 1)
+    return;
 
-  if (v)
-    ds->raw[bytepos] |= (0x80 >> bitpos);
+  if ((ds->cells[p >> 3] >> (p & 7)) & 1)
+    ds->raw[ds->data_bits >> 3] |= 0x80 >> (ds->data_bits & 7);
 
   ds->data_bits++;
 }
 
+/* Unmasks the grid first, so that reading a data cell is a bit test.
+ * Versions with a table of their data cells read them straight from
+ * it, the others mark their function patterns up front and walk the
+ * grid, skipping those.
+ */
 static void read_data(const struct quirc_code *code,
-                      struct quirc_data *data,
                       struct datastream *ds)
 {
+  const struct quirc_version_tables *tables =
+      &quirc_version_tables[ds->version];
   int y = code->size - 1;
   int x = code->size - 1;
   int dir = -1;
 
+  unmask_cells(code, ds->mask, ds->cells);
+
+  if (tables->data_order)
+  {
+    const uint16_t *order = tables->data_order;
+    int i;
+
+    for (i = 0; i < tables->data_cells; i++)
+    {
+      const int p = order[i];
+
+      if ((ds->cells[p >> 3] >> (p & 7)) & 1)
+        ds->raw[i >> 3] |= 0x80 >> (i & 7);
+    }
+
+    ds->data_bits = tables->data_cells;
+    return;
+  }
+
+  quirc_reserve_functions(ds->version, ds->reserved);
+
   while (x > 0)
   {
+    int p;
+
     if (x == 6)
       x--;
 
-    if (!reserved_cell(data->version, y, x))
-      read_bit(code, data, ds, y, x);
-
-    if (!reserved_cell(data->version, y, x - 1))
-      read_bit(code, data, ds, y, x - 1);
+    p = y * code->size + x;
+    read_cell(ds, p);
+    read_cell(ds, p - 1);
 
     y += dir;
     if (y < 0 || y >= code->size)
@@ -598,17 +772,16 @@ static void read_data(const struct quirc_code *code,
   }
 }
 
-static quirc_decode_error_t codestream_ecc(struct quirc_data *data,
-                                           struct datastream *ds)
+static quirc_decode_error_t codestream_ecc(struct datastream *ds)
 {
   const struct quirc_version_info *ver =
-      &quirc_version_db[data->version];
-  const struct quirc_rs_params *sb_ecc = &ver->ecc[data->ecc_level];
+      &quirc_version_db[ds->version];
+  const struct quirc_rs_params *sb_ecc = &ver->ecc[ds->ecc_level];
+  const struct quirc_block_layout *layout =
+      &quirc_version_tables[ds->version].layout[ds->ecc_level];
   struct quirc_rs_params lb_ecc;
-  const int lb_count =
-      (ver->data_bytes - sb_ecc->bs * sb_ecc->ns) / (sb_ecc->bs + 1);
-  const int bc = lb_count + sb_ecc->ns;
-  const int ecc_offset = sb_ecc->dw * bc + lb_count;
+  const int bc = layout->blocks;
+  const int ecc_offset = layout->ecc_offset;
   int dst_offset = 0;
   int i;
 
@@ -667,8 +840,7 @@ static int take_bits(struct datastream *ds, int len)
   return ret;
 }
 
-static int numeric_tuple(struct quirc_data *data,
-                         struct datastream *ds,
+static int numeric_tuple(struct datastream *ds,
                          int bits, int digits)
 {
   int tuple;
@@ -681,46 +853,45 @@ static int numeric_tuple(struct quirc_data *data,
 
   for (i = digits - 1; i >= 0; i--)
   {
-    data->payload[data->payload_len + i] = tuple % 10 + '0';
+    ds->out[ds->out_len + i] = tuple % 10 + '0';
     tuple /= 10;
   }
 
-  data->payload_len += digits;
+  ds->out_len += digits;
   return 0;
 }
 
-static quirc_decode_error_t decode_numeric(struct quirc_data *data,
-                                           struct datastream *ds)
+static quirc_decode_error_t decode_numeric(struct datastream *ds)
 {
   int bits = 14;
   int count;
 
-  if (data->version < 10)
+  if (ds->version < 10)
     bits = 10;
-  else if (data->version < 27)
+  else if (ds->version < 27)
     bits = 12;
 
   count = take_bits(ds, bits);
-  if (data->payload_len + count + 1 > QUIRC_MAX_PAYLOAD)
+  if (ds->out_len + count + 1 > QUIRC_MAX_PAYLOAD)
     return QUIRC_ERROR_DATA_OVERFLOW;
 
   while (count >= 3)
   {
-    if (numeric_tuple(data, ds, 10, 3) < 0)
+    if (numeric_tuple(ds, 10, 3) < 0)
       return QUIRC_ERROR_DATA_UNDERFLOW;
     count -= 3;
   }
 
   if (count >= 2)
   {
-    if (numeric_tuple(data, ds, 7, 2) < 0)
+    if (numeric_tuple(ds, 7, 2) < 0)
       return QUIRC_ERROR_DATA_UNDERFLOW;
     count -= 2;
   }
 
   if (count)
   {
-    if (numeric_tuple(data, ds, 4, 1) < 0)
+    if (numeric_tuple(ds, 4, 1) < 0)
       return QUIRC_ERROR_DATA_UNDERFLOW;
     count--;
   }
@@ -728,8 +899,7 @@ static quirc_decode_error_t decode_numeric(struct quirc_data *data,
   return QUIRC_SUCCESS;
 }
 
-static int alpha_tuple(struct quirc_data *data,
-                       struct datastream *ds,
+static int alpha_tuple(struct datastream *ds,
                        int bits, int digits)
 {
   int tuple;
@@ -745,40 +915,39 @@ static int alpha_tuple(struct quirc_data *data,
     static const char *alpha_map =
         "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
 
-    data->payload[data->payload_len + digits - i - 1] =
+    ds->out[ds->out_len + digits - i - 1] =
         alpha_map[tuple % 45];
     tuple /= 45;
   }
 
-  data->payload_len += digits;
+  ds->out_len += digits;
   return 0;
 }
 
-static quirc_decode_error_t decode_alpha(struct quirc_data *data,
-                                         struct datastream *ds)
+static quirc_decode_error_t decode_alpha(struct datastream *ds)
 {
   int bits = 13;
   int count;
 
-  if (data->version < 10)
+  if (ds->version < 10)
     bits = 9;
-  else if (data->version < 27)
+  else if (ds->version < 27)
     bits = 11;
 
   count = take_bits(ds, bits);
-  if (data->payload_len + count + 1 > QUIRC_MAX_PAYLOAD)
+  if (ds->out_len + count + 1 > QUIRC_MAX_PAYLOAD)
     return QUIRC_ERROR_DATA_OVERFLOW;
 
   while (count >= 2)
   {
-    if (alpha_tuple(data, ds, 11, 2) < 0)
+    if (alpha_tuple(ds, 11, 2) < 0)
       return QUIRC_ERROR_DATA_UNDERFLOW;
     count -= 2;
   }
 
   if (count)
   {
-    if (alpha_tuple(data, ds, 6, 1) < 0)
+    if (alpha_tuple(ds, 6, 1) < 0)
       return QUIRC_ERROR_DATA_UNDERFLOW;
     count--;
   }
@@ -786,42 +955,40 @@ static quirc_decode_error_t decode_alpha(struct quirc_data *data,
   return QUIRC_SUCCESS;
 }
 
-static quirc_decode_error_t decode_byte(struct quirc_data *data,
-                                        struct datastream *ds)
+static quirc_decode_error_t decode_byte(struct datastream *ds)
 {
   int bits = 16;
   int count;
   int i;
 
-  if (data->version < 10)
+  if (ds->version < 10)
     bits = 8;
 
   count = take_bits(ds, bits);
-  if (data->payload_len + count + 1 > QUIRC_MAX_PAYLOAD)
+  if (ds->out_len + count + 1 > QUIRC_MAX_PAYLOAD)
     return QUIRC_ERROR_DATA_OVERFLOW;
   if (bits_remaining(ds) < count * 8)
     return QUIRC_ERROR_DATA_UNDERFLOW;
 
   for (i = 0; i < count; i++)
-    data->payload[data->payload_len++] = take_bits(ds, 8);
+    ds->out[ds->out_len++] = take_bits(ds, 8);
 
   return QUIRC_SUCCESS;
 }
 
-static quirc_decode_error_t decode_kanji(struct quirc_data *data,
-                                         struct datastream *ds)
+static quirc_decode_error_t decode_kanji(struct datastream *ds)
 {
   int bits = 12;
   int count;
   int i;
 
-  if (data->version < 10)
+  if (ds->version < 10)
     bits = 8;
-  else if (data->version < 27)
+  else if (ds->version < 27)
     bits = 10;
 
   count = take_bits(ds, bits);
-  if (data->payload_len + count * 2 + 1 > QUIRC_MAX_PAYLOAD)
+  if (ds->out_len + count * 2 + 1 > QUIRC_MAX_PAYLOAD)
     return QUIRC_ERROR_DATA_OVERFLOW;
   if (bits_remaining(ds) < count * 13)
     return QUIRC_ERROR_DATA_UNDERFLOW;
@@ -845,41 +1012,39 @@ static quirc_decode_error_t decode_kanji(struct quirc_data *data,
       sjw = intermediate + 0xc140;
     }
 
-    data->payload[data->payload_len++] = sjw >> 8;
-    data->payload[data->payload_len++] = sjw & 0xff;
+    ds->out[ds->out_len++] = sjw >> 8;
+    ds->out[ds->out_len++] = sjw & 0xff;
   }
 
   return QUIRC_SUCCESS;
 }
 
-static quirc_decode_error_t decode_eci(struct quirc_data *data,
-                                       struct datastream *ds)
+static quirc_decode_error_t decode_eci(struct datastream *ds)
 {
   if (bits_remaining(ds) < 8)
     return QUIRC_ERROR_DATA_UNDERFLOW;
 
-  data->eci = take_bits(ds, 8);
+  ds->eci = take_bits(ds, 8);
 
-  if ((data->eci & 0xc0) == 0x80)
+  if ((ds->eci & 0xc0) == 0x80)
   {
     if (bits_remaining(ds) < 8)
       return QUIRC_ERROR_DATA_UNDERFLOW;
 
-    data->eci = (data->eci << 8) | take_bits(ds, 8);
+    ds->eci = (ds->eci << 8) | take_bits(ds, 8);
   }
-  else if ((data->eci & 0xe0) == 0xc0)
+  else if ((ds->eci & 0xe0) == 0xc0)
   {
     if (bits_remaining(ds) < 16)
       return QUIRC_ERROR_DATA_UNDERFLOW;
 
-    data->eci = (data->eci << 16) | take_bits(ds, 16);
+    ds->eci = (ds->eci << 16) | take_bits(ds, 16);
   }
 
   return QUIRC_SUCCESS;
 }
 
-static quirc_decode_error_t decode_payload(struct quirc_data *data,
-                                           struct datastream *ds)
+static quirc_decode_error_t decode_payload(struct datastream *ds)
 {
   while (bits_remaining(ds) >= 4)
   {
@@ -889,23 +1054,23 @@ static quirc_decode_error_t decode_payload(struct quirc_data *data,
     switch (type)
     {
     case QUIRC_DATA_TYPE_NUMERIC:
-      err = decode_numeric(data, ds);
+      err = decode_numeric(ds);
       break;
 
     case QUIRC_DATA_TYPE_ALPHA:
-      err = decode_alpha(data, ds);
+      err = decode_alpha(ds);
       break;
 
     case QUIRC_DATA_TYPE_BYTE:
-      err = decode_byte(data, ds);
+      err = decode_byte(ds);
       break;
 
     case QUIRC_DATA_TYPE_KANJI:
-      err = decode_kanji(data, ds);
+      err = decode_kanji(ds);
       break;
 
-    case 7:
-      err = decode_eci(data, ds);
+    case QUIRC_DATA_TYPE_ECI:
+      err = decode_eci(ds);
       break;
 
     default:
@@ -915,69 +1080,144 @@ static quirc_decode_error_t decode_payload(struct quirc_data *data,
     if (err)
       return err;
 
-    if (!(type & (type - 1)) && (type > data->data_type))
-      data->data_type = type;
+    if (!(type & (type - 1)) && (type > ds->data_type))
+      ds->data_type = type;
+
+    if (ds->fn)
+    {
+      struct quirc_segment seg;
+
+      ds->out[ds->out_len] = 0;
+      seg.data_type = type;
+      seg.eci = ds->eci;
+      seg.data = ds->out;
+      seg.len = ds->out_len;
+      ds->fn(ds->arg, &seg);
+      ds->out_len = 0;
+    }
   }
 
 done:
 
   /* Add nul terminator to all payloads */
-  if (data->payload_len >= sizeof(data->payload))
-    data->payload_len--;
-  data->payload[data->payload_len] = 0;
+  if (ds->out_len >= QUIRC_MAX_PAYLOAD)
+    ds->out_len--;
+  ds->out[ds->out_len] = 0;
 
   return QUIRC_SUCCESS;
 }
 
-quirc_decode_error_t quirc_decode(const struct quirc_code *code,
-                                  struct quirc_data *data)
+struct quirc_decoder
+{
+  struct datastream ds;
+} __attribute__((aligned(8)));
+
+struct quirc_decoder *quirc_decoder_new(void)
+{
+  return ps_malloc(sizeof(struct quirc_decoder));
+}
+
+void quirc_decoder_destroy(struct quirc_decoder *d)
+{
+  free(d);
+}
+
+static quirc_decode_error_t decode_stream(const struct quirc_code *code,
+                                          struct datastream *ds)
 {
   quirc_decode_error_t err;
-  struct datastream *ds = ps_malloc(sizeof(struct datastream));
+
+  ds->version = (code->size - 17) / 4;
+  ds->ecc_level = 0;
+  ds->mask = 0;
+  ds->out_len = 0;
+  ds->data_type = 0;
+  ds->eci = 0;
 
   if ((code->size - 17) % 4)
-  {
-    free(ds);
     return QUIRC_ERROR_INVALID_GRID_SIZE;
-  }
-
-  memset(data, 0, sizeof(*data));
-  memset(ds, 0, sizeof(*ds));
 
-  data->version = (code->size - 17) / 4;
-
-  if (data->version < 1 ||
-      data->version > QUIRC_MAX_VERSION)
-  {
-    free(ds);
+  if (ds->version < 1 ||
+      ds->version > QUIRC_MAX_VERSION)
     return QUIRC_ERROR_INVALID_VERSION;
-  }
 
   /* Read format information -- try both locations */
-  err = read_format(code, data, 0);
+  err = read_format(code, ds, 0);
   if (err)
-    err = read_format(code, data, 1);
+    err = read_format(code, ds, 1);
   if (err)
-  {
-    free(ds);
     return err;
-  }
 
-  read_data(code, data, ds);
-  err = codestream_ecc(data, ds);
+  /* Of the scratch space, only the raw stream is read before it is
+   * written, as its bits are set one by one.
+   */
+  memset(ds->raw, 0, quirc_version_db[ds->version].data_bytes + 1);
+  ds->data_bits = 0;
+  ds->ptr = 0;
+
+  read_data(code, ds);
+  err = codestream_ecc(ds);
   if (err)
-  {
-    free(ds);
     return err;
-  }
 
-  err = decode_payload(data, ds);
+  err = decode_payload(ds);
   if (err)
-  {
-    free(ds);
-    return err;
-  }
+    ds->out[ds->out_len] = 0;
 
-  free(ds);
-  return QUIRC_SUCCESS;
-}
\ No newline at end of file
+  return err;
+}
+
+quirc_decode_error_t quirc_decode_with(struct quirc_decoder *d,
+                                       const struct quirc_code *code,
+                                       struct quirc_data *data)
+{
+  struct datastream *ds = &d->ds;
+  quirc_decode_error_t err;
+
+  if ((code->size - 17) % 4)
+    return QUIRC_ERROR_INVALID_GRID_SIZE;
+
+  /* The payload is written up to payload_len and terminated */
+  data->payload[0] = 0;
+  ds->out = data->payload;
+  ds->fn = NULL;
+
+  err = decode_stream(code, ds);
+
+  data->version = ds->version;
+  data->ecc_level = ds->ecc_level;
+  data->mask = ds->mask;
+  data->data_type = ds->data_type;
+  data->payload_len = ds->out_len;
+  data->eci = ds->eci;
+
+  return err;
+}
+
+quirc_decode_error_t quirc_decode_segments(struct quirc_decoder *d,
+                                           const struct quirc_code *code,
+                                           quirc_segment_fn fn, void *arg)
+{
+  struct datastream *ds = &d->ds;
+
+  ds->out = ds->raw;
+  ds->fn = fn;
+  ds->arg = arg;
+
+  return decode_stream(code, ds);
+}
+
+quirc_decode_error_t quirc_decode(const struct quirc_code *code,
+                                  struct quirc_data *data)
+{
+  struct quirc_decoder *d = quirc_decoder_new();
+  quirc_decode_error_t err;
+
+  if (!d)
+    return QUIRC_ERROR_OUT_OF_MEMORY;
+
+  err = quirc_decode_with(d, code, data);
+
+  quirc_decoder_destroy(d);
+  return err;
+}
@@ -13,11 +13,14 @@
 
 static inline float fast_sqrtf(float x)
 {
-  //return sqrtf(x);
+#if defined(__XTENSA__)
   asm("fsqrt.s %0, %1"
       : "=f"(x)
       : "f"(x));
   return x;
+#else
+  return sqrtf(x);
+#endif
 }
 static inline int fast_floorf(float x)
 {
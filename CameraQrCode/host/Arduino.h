@@ -0,0 +1,20 @@
+/* Host build stand-in for the Arduino core header.
+ *
+ * Only the pieces the quirc sources rely on are provided: PSRAM and
+ * internal RAM allocations both come from the regular heap.
+ */
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ps_malloc(size) malloc(size)
+
+#define MALLOC_CAP_8BIT 0
+#define MALLOC_CAP_INTERNAL 0
+#define heap_caps_malloc(size, caps) malloc(size)
+
+#endif
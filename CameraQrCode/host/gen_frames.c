@@ -0,0 +1,533 @@
+/* gen_frames -- write synthetic camera frames for qrbench
+ *
+ *   gen_frames dir [count]
+ *
+ * Writes count (default 16) binary PGM frames to dir, each holding one
+ * QR-code on a plane tilted away from the camera, over a shaded
+ * background with noise. The codes are encoded here from
+ * quirc_version_db: byte mode, versions 1 to 10, every ECC level and
+ * mask. Frames are the same from run to run, so that make compare has
+ * something to run on in a fresh checkout. A line per frame on stdout
+ * gives its version, ECC level, mask, tilt and payload.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "quirc_internal.h"
+
+#define MAX_SIZE (QUIRC_MAX_VERSION * 4 + 17)
+
+static uint32_t rng_state;
+
+/* xorshift32, for frames which don't depend on the C library */
+static uint32_t rng(void)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static int rng_int(int lo, int hi)
+{
+  return lo + (int)(rng() % (uint32_t)(hi - lo + 1));
+}
+
+static double rng_real(double lo, double hi)
+{
+  return lo + (hi - lo) * (rng() >> 8) / (double)(1 << 24);
+}
+
+/************************************************************************
+ * Encoding
+ */
+
+static uint8_t gf_exp[512];
+static uint8_t gf_log[256];
+
+static void gf_init(void)
+{
+  int x = 1;
+  int i;
+
+  for (i = 0; i < 255; i++)
+  {
+    gf_exp[i] = x;
+    gf_log[x] = i;
+    x <<= 1;
+    if (x & 0x100)
+      x ^= 0x11d;
+  }
+  for (i = 255; i < 512; i++)
+    gf_exp[i] = gf_exp[i - 255];
+}
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+  if (!a || !b)
+    return 0;
+  return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+/* Appends the npar ECC words of a block of n data words */
+static void rs_encode(const uint8_t *data, int n, int npar, uint8_t *ecc)
+{
+  uint8_t gen[256];
+  int i, j;
+
+  memset(gen, 0, sizeof(gen));
+  gen[0] = 1;
+  for (i = 0; i < npar; i++)
+    for (j = i + 1; j > 0; j--)
+      gen[j] ^= gf_mul(gen[j - 1], gf_exp[i]);
+
+  memset(ecc, 0, npar);
+  for (i = 0; i < n; i++)
+  {
+    uint8_t f = data[i] ^ ecc[0];
+
+    memmove(ecc, ecc + 1, npar - 1);
+    ecc[npar - 1] = 0;
+    for (j = 0; j < npar; j++)
+      ecc[j] ^= gf_mul(gen[j + 1], f);
+  }
+}
+
+static int mask_bit(int mask, int i, int j)
+{
+  switch (mask)
+  {
+  case 0:
+    return !((i + j) % 2);
+  case 1:
+    return !(i % 2);
+  case 2:
+    return !(j % 3);
+  case 3:
+    return !((i + j) % 3);
+  case 4:
+    return !(((i / 2) + (j / 3)) % 2);
+  case 5:
+    return !((i * j) % 2 + (i * j) % 3);
+  case 6:
+    return !(((i * j) % 2 + (i * j) % 3) % 2);
+  case 7:
+    return !(((i * j) % 3 + (i + j) % 2) % 2);
+  }
+
+  return 0;
+}
+
+static uint16_t format_word(int ecc_level, int mask)
+{
+  uint32_t d = (ecc_level << 3) | mask;
+  uint32_t v = d << 10;
+  int i;
+
+  for (i = 14; i >= 10; i--)
+    if (v & (1u << i))
+      v ^= 0x537u << (i - 10);
+
+  return ((d << 10) | v) ^ 0x5412;
+}
+
+static uint32_t version_word(int version)
+{
+  uint32_t v = (uint32_t)version << 12;
+  int i;
+
+  for (i = 17; i >= 12; i--)
+    if (v & (1u << i))
+      v ^= 0x1f25u << (i - 12);
+
+  return ((uint32_t)version << 12) | v;
+}
+
+struct bit_writer
+{
+  uint8_t *buf;
+  int pos;
+};
+
+static void put_bits(struct bit_writer *w, uint32_t v, int n)
+{
+  while (n--)
+  {
+    if ((v >> n) & 1)
+      w->buf[w->pos >> 3] |= 0x80 >> (w->pos & 7);
+    w->pos++;
+  }
+}
+
+static void finder(uint8_t *g, int size, int top, int left)
+{
+  int r, c;
+
+  for (r = -1; r <= 7; r++)
+    for (c = -1; c <= 7; c++)
+    {
+      int y = top + r;
+      int x = left + c;
+      int on = r >= 0 && r <= 6 && c >= 0 && c <= 6 &&
+               (r == 0 || r == 6 || c == 0 || c == 6 ||
+                (r >= 2 && r <= 4 && c >= 2 && c <= 4));
+
+      if (y >= 0 && y < size && x >= 0 && x < size)
+        g[y * size + x] = on;
+    }
+}
+
+/* Encodes a byte mode payload into g, one cell per byte, row by row.
+ * Returns 0, or -1 if the payload does not fit.
+ */
+static int encode(const uint8_t *payload, int len, int version,
+                  int ecc_level, int mask, uint8_t *g)
+{
+  const struct quirc_version_info *ver = &quirc_version_db[version];
+  const struct quirc_rs_params *sb = &ver->ecc[ecc_level];
+  const int size = version * 4 + 17;
+  const int large = (ver->data_bytes - sb->bs * sb->ns) / (sb->bs + 1);
+  const int blocks = sb->ns + large;
+  const int npar = sb->bs - sb->dw;
+  const int data_words = sb->dw * blocks + large;
+  static uint8_t data[QUIRC_MAX_PAYLOAD];
+  static uint8_t stream[QUIRC_MAX_PAYLOAD];
+  static uint8_t ecc[256][256];
+  static uint8_t plane[QUIRC_MAX_BITMAP];
+  struct bit_writer w = {data, 0};
+  uint16_t format;
+  int n = 0;
+  int i, j, k;
+  int x, y, dir;
+  int apat = 0;
+
+  if (4 + (version < 10 ? 8 : 16) + len * 8 > data_words * 8)
+    return -1;
+
+  /* Data words, padded */
+  memset(data, 0, sizeof(data));
+  put_bits(&w, 4, 4);
+  put_bits(&w, len, version < 10 ? 8 : 16);
+  for (i = 0; i < len; i++)
+    put_bits(&w, payload[i], 8);
+  for (i = (w.pos + 7) >> 3; i < data_words; i++)
+    data[i] = (i - ((w.pos + 7) >> 3)) & 1 ? 0x11 : 0xec;
+
+  /* Blocks, interleaved */
+  for (i = 0, k = 0; i < blocks; i++)
+  {
+    int dw = sb->dw + (i >= sb->ns);
+
+    rs_encode(data + k, dw, npar, ecc[i]);
+    k += dw;
+  }
+  for (j = 0; j <= sb->dw; j++)
+    for (i = 0; i < blocks; i++)
+      if (j < sb->dw + (i >= sb->ns))
+        stream[n++] = data[i * sb->dw + (i > sb->ns ? i - sb->ns : 0) + j];
+  for (j = 0; j < npar; j++)
+    for (i = 0; i < blocks; i++)
+      stream[n++] = ecc[i][j];
+
+  /* Function patterns */
+  memset(g, 0, size * size);
+  finder(g, size, 0, 0);
+  finder(g, size, 0, size - 7);
+  finder(g, size, size - 7, 0);
+
+  for (i = 8; i < size - 8; i++)
+    g[6 * size + i] = g[i * size + 6] = !(i & 1);
+
+  while (apat < QUIRC_MAX_ALIGNMENT && ver->apat[apat])
+    apat++;
+  for (i = 0; i < apat; i++)
+    for (j = 0; j < apat; j++)
+    {
+      int r, c;
+
+      if ((!i || i == apat - 1) && (!j || j == apat - 1) && (!i || !j))
+        continue;
+
+      for (r = -2; r <= 2; r++)
+        for (c = -2; c <= 2; c++)
+          g[(ver->apat[i] + r) * size + ver->apat[j] + c] =
+              abs(r) == 2 || abs(c) == 2 || (!r && !c);
+    }
+
+  /* Format, with the dark module, and version */
+  format = format_word(ecc_level, mask);
+  {
+    static const int xs[15] = {
+        8, 8, 8, 8, 8, 8, 8, 8, 7, 5, 4, 3, 2, 1, 0};
+    static const int ys[15] = {
+        0, 1, 2, 3, 4, 5, 7, 8, 8, 8, 8, 8, 8, 8, 8};
+
+    for (i = 0; i < 15; i++)
+      g[ys[i] * size + xs[i]] = (format >> i) & 1;
+  }
+  for (i = 0; i < 7; i++)
+    g[(size - 1 - i) * size + 8] = (format >> (14 - i)) & 1;
+  for (i = 0; i < 8; i++)
+    g[8 * size + size - 8 + i] = (format >> (7 - i)) & 1;
+  g[(size - 8) * size + 8] = 1;
+
+  if (version >= 7)
+  {
+    uint32_t v = version_word(version);
+
+    for (i = 0; i < 18; i++)
+    {
+      int b = (v >> i) & 1;
+
+      g[(i / 3) * size + size - 11 + i % 3] = b;
+      g[(size - 11 + i % 3) * size + i / 3] = b;
+    }
+  }
+
+  /* Data, in the order read_data() walks the grid */
+  quirc_reserve_functions(version, plane);
+  k = 0;
+  y = size - 1;
+  x = size - 1;
+  dir = -1;
+  while (x > 0)
+  {
+    if (x == 6)
+      x--;
+
+    for (i = 0; i < 2; i++)
+    {
+      int p = y * size + x - i;
+      int bit;
+
+      if ((plane[p >> 3] >> (p & 7)) & 1)
+        continue;
+
+      bit = k < n * 8 ? (stream[k >> 3] >> (7 - (k & 7))) & 1 : 0;
+      g[p] = bit ^ mask_bit(mask, y, x - i);
+      k++;
+    }
+
+    y += dir;
+    if (y < 0 || y >= size)
+    {
+      dir = -dir;
+      x -= 2;
+      y += dir;
+    }
+  }
+
+  return 0;
+}
+
+/************************************************************************
+ * Rendering
+ */
+
+/* Maps image points back onto the grid: the inverse of the homography
+ * taking the grid's corners to where a tilted, rotated plane puts them.
+ */
+static void grid_transform(int size, double scale, double cx, double cy,
+                           double angle, double tilt_x, double tilt_y,
+                           double f, double inv[9])
+{
+  static const int corner[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  double m[8][9];
+  double h[9];
+  int i, j, k;
+
+  for (i = 0; i < 4; i++)
+  {
+    double u = corner[i][0] * size;
+    double v = corner[i][1] * size;
+    double px = (u - size / 2.0) * scale;
+    double py = (v - size / 2.0) * scale;
+    double pz = px * sin(tilt_y);
+    double x, y, d;
+
+    px *= cos(tilt_y);
+    pz += py * sin(tilt_x);
+    py *= cos(tilt_x);
+    x = px * cos(angle) - py * sin(angle);
+    y = px * sin(angle) + py * cos(angle);
+    d = f / (f + pz);
+    x = cx + x * d;
+    y = cy + y * d;
+
+    memset(m[i * 2], 0, sizeof(m[0]) * 2);
+    m[i * 2][0] = m[i * 2 + 1][3] = u;
+    m[i * 2][1] = m[i * 2 + 1][4] = v;
+    m[i * 2][2] = m[i * 2 + 1][5] = 1;
+    m[i * 2][6] = -u * x;
+    m[i * 2][7] = -v * x;
+    m[i * 2][8] = x;
+    m[i * 2 + 1][6] = -u * y;
+    m[i * 2 + 1][7] = -v * y;
+    m[i * 2 + 1][8] = y;
+  }
+
+  /* Gauss-Jordan, with partial pivoting */
+  for (i = 0; i < 8; i++)
+  {
+    int best = i;
+
+    for (j = i + 1; j < 8; j++)
+      if (fabs(m[j][i]) > fabs(m[best][i]))
+        best = j;
+    for (k = 0; k < 9; k++)
+    {
+      double t = m[i][k];
+
+      m[i][k] = m[best][k];
+      m[best][k] = t;
+    }
+
+    for (j = 0; j < 8; j++)
+    {
+      double r = m[j][i] / m[i][i];
+
+      if (j == i)
+        continue;
+      for (k = i; k < 9; k++)
+        m[j][k] -= r * m[i][k];
+    }
+  }
+
+  for (i = 0; i < 8; i++)
+    h[i] = m[i][8] / m[i][i];
+  h[8] = 1;
+
+  inv[0] = h[4] * h[8] - h[5] * h[7];
+  inv[1] = h[2] * h[7] - h[1] * h[8];
+  inv[2] = h[1] * h[5] - h[2] * h[4];
+  inv[3] = h[5] * h[6] - h[3] * h[8];
+  inv[4] = h[0] * h[8] - h[2] * h[6];
+  inv[5] = h[2] * h[3] - h[0] * h[5];
+  inv[6] = h[3] * h[7] - h[4] * h[6];
+  inv[7] = h[1] * h[6] - h[0] * h[7];
+  inv[8] = h[0] * h[4] - h[1] * h[3];
+}
+
+/* Four samples a pixel, over a background shading from left to right */
+static void render(const uint8_t *g, int size, const double inv[9],
+                   uint8_t *img, int w, int h, int noise)
+{
+  int x, y;
+
+  for (y = 0; y < h; y++)
+    for (x = 0; x < w; x++)
+    {
+      int base = 200 - 60 * x / w;
+      int acc = 0;
+      int s;
+
+      for (s = 0; s < 4; s++)
+      {
+        double px = x + 0.25 + 0.5 * (s & 1);
+        double py = y + 0.25 + 0.5 * (s >> 1);
+        double d = inv[6] * px + inv[7] * py + inv[8];
+        int u = (int)floor((inv[0] * px + inv[1] * py + inv[2]) / d);
+        int v = (int)floor((inv[3] * px + inv[4] * py + inv[5]) / d);
+
+        if (u >= 0 && u < size && v >= 0 && v < size && g[v * size + u])
+          acc += 40 + (base - 200) / 3;
+        else
+          acc += base;
+      }
+
+      acc = acc / 4 + rng_int(-noise, noise);
+      img[y * w + x] = acc < 0 ? 0 : acc > 255 ? 255 : acc;
+    }
+}
+
+static int write_pgm(const char *path, const uint8_t *img, int w, int h)
+{
+  FILE *f = fopen(path, "wb");
+
+  if (!f)
+  {
+    perror(path);
+    return -1;
+  }
+
+  fprintf(f, "P5\n%d %d\n255\n", w, h);
+  fwrite(img, 1, (size_t)w * h, f);
+  if (fclose(f))
+  {
+    perror(path);
+    return -1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  static const int versions[] = {1, 2, 3, 4, 5, 6, 7, 8, 10};
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  static uint8_t grid[MAX_SIZE * MAX_SIZE];
+  static uint8_t img[480 * 360];
+  int count = argc > 2 ? atoi(argv[2]) : 16;
+  int i;
+
+  if (argc < 2 || count < 1)
+  {
+    fprintf(stderr, "usage: %s dir [count]\n", argv[0]);
+    return 2;
+  }
+
+  if (mkdir(argv[1], 0777) && access(argv[1], W_OK))
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  gf_init();
+  rng_state = 7;
+
+  for (i = 0; i < count; i++)
+  {
+    int version = versions[rng_int(0, sizeof(versions) / sizeof(versions[0]) - 1)];
+    int size = version * 4 + 17;
+    int w = version > 4 ? 480 : 320;
+    int h = version > 4 ? 360 : 240;
+    int ecc_level = rng_int(0, 3);
+    int mask = rng_int(0, 7);
+    double scale = rng_real(2.6, fmin(5.0, 0.75 * h / size));
+    double tilt_x = rng_real(-0.9, 0.9);
+    double tilt_y = rng_real(-0.9, 0.9);
+    double angle = rng_real(-M_PI, M_PI);
+    double cx = w / 2 + rng_real(-20, 20);
+    double cy = h / 2 + rng_real(-15, 15);
+    int noise = rng_int(2, 14);
+    uint8_t payload[80];
+    char path[1024];
+    double inv[9];
+    int len;
+    int j;
+
+    len = snprintf((char *)payload, sizeof(payload), "skew%02d-", i);
+    for (j = rng_int(4, 60); j > 0; j--)
+      payload[len++] = alphabet[rng_int(0, sizeof(alphabet) - 2)];
+
+    while (encode(payload, len, version, ecc_level, mask, grid) < 0)
+      len--;
+
+    grid_transform(size, scale, cx, cy, angle, tilt_x, tilt_y, 1.2 * w, inv);
+    render(grid, size, inv, img, w, h, noise);
+
+    snprintf(path, sizeof(path), "%s/s%02d.pgm", argv[1], i);
+    if (write_pgm(path, img, w, h) < 0)
+      return 1;
+
+    printf("s%02d.pgm v%d ecc %d mask %d tilt %.2f %.2f: %.*s\n", i,
+           version, ecc_level, mask, tilt_x, tilt_y, len, payload);
+  }
+
+  return 0;
+}
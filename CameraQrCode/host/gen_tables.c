@@ -0,0 +1,129 @@
+/* gen_tables -- write version_tables.c from quirc_version_db
+ *
+ *   gen_tables [max_version] > version_tables.c
+ *
+ * For every version, the layout of its blocks at each ECC level as
+ * codestream_ecc() uses it. For versions up to max_version (default
+ * 10), the order in which read_data() takes the data cells: the same
+ * walk it makes over the grid, two columns at a time from the bottom
+ * right, skipping function patterns.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "quirc_internal.h"
+
+#define PER_LINE 10
+
+static int data_order(int version, uint16_t *order)
+{
+  static uint8_t plane[QUIRC_MAX_BITMAP];
+  const int size = version * 4 + 17;
+  int y = size - 1;
+  int x = size - 1;
+  int dir = -1;
+  int n = 0;
+
+  quirc_reserve_functions(version, plane);
+
+  while (x > 0)
+  {
+    int k;
+
+    if (x == 6)
+      x--;
+
+    for (k = 0; k < 2; k++)
+    {
+      int p = y * size + x - k;
+
+      if (!((plane[p >> 3] >> (p & 7)) & 1))
+        order[n++] = p;
+    }
+
+    y += dir;
+    if (y < 0 || y >= size)
+    {
+      dir = -dir;
+      x -= 2;
+      y += dir;
+    }
+  }
+
+  return n;
+}
+
+static void print_order(int version, const uint16_t *order, int n)
+{
+  int i;
+
+  printf("#if QUIRC_TABLE_VERSIONS >= %d\n", version);
+  printf("static const uint16_t data_order_%d[%d] = {", version, n);
+  for (i = 0; i < n; i++)
+    printf("%s%d", !i ? "\n    " : i % PER_LINE ? ", " : ",\n    ", order[i]);
+  printf("};\n#endif\n\n");
+}
+
+static void print_version(int version, int n, int max_version)
+{
+  const struct quirc_version_info *ver = &quirc_version_db[version];
+  int level;
+
+  printf("    {/* Version %d */\n", version);
+  printf("     .layout = {");
+  for (level = 0; level < 4; level++)
+  {
+    const struct quirc_rs_params *sb = &ver->ecc[level];
+    int large = (ver->data_bytes - sb->bs * sb->ns) / (sb->bs + 1);
+    int blocks = large + sb->ns;
+
+    printf("\n         {.blocks = %d, .ecc_offset = %d}%s", blocks,
+           sb->dw * blocks + large, level < 3 ? "," : "},\n");
+  }
+  printf("     .data_cells = %d,\n", n);
+  if (version <= max_version)
+    printf("#if QUIRC_TABLE_VERSIONS >= %d\n"
+           "     .data_order = data_order_%d\n"
+           "#endif\n",
+           version, version);
+  printf("    }%s\n", version < QUIRC_MAX_VERSION ? "," : "};");
+}
+
+int main(int argc, char **argv)
+{
+  static uint16_t order[QUIRC_MAX_VERSION + 1][QUIRC_MAX_BITMAP * 8];
+  int cells[QUIRC_MAX_VERSION + 1];
+  int max_version = argc > 1 ? atoi(argv[1]) : 10;
+  int v;
+
+  if (max_version < 0 || max_version > QUIRC_MAX_VERSION)
+  {
+    fprintf(stderr, "usage: %s [max_version 0-%d]\n", argv[0], QUIRC_MAX_VERSION);
+    return 2;
+  }
+
+  for (v = 1; v <= QUIRC_MAX_VERSION; v++)
+    cells[v] = data_order(v, order[v]);
+
+  printf("/* Generated from quirc_version_db by host/gen_tables.c: run\n"
+         " * \"make tables\" there, with VERSIONS=n for data cell orders up\n"
+         " * to version n, rather than editing this file.\n"
+         " */\n\n"
+         "#include \"quirc_internal.h\"\n\n");
+  printf("#if QUIRC_TABLE_VERSIONS > %d\n"
+         "#error \"version_tables.c has data cell orders up to version %d only\"\n"
+         "#endif\n\n",
+         max_version, max_version);
+
+  for (v = 1; v <= max_version; v++)
+    print_order(v, order[v], cells[v]);
+
+  printf("const struct quirc_version_tables quirc_version_tables[QUIRC_MAX_VERSION + 1] = {\n"
+         "    {.data_cells = 0},\n");
+  for (v = 1; v <= QUIRC_MAX_VERSION; v++)
+    print_version(v, cells[v], max_version);
+
+  return 0;
+}
@@ -0,0 +1,783 @@
+/* qrbench -- replay grayscale frames through quirc and time each stage
+ *
+ * Every frame in the given directory is loaded once and then fed to
+ * quirc_begin()/quirc_end() the requested number of times. Each grid
+ * found is extracted and decoded. Per-stage timings are collected for
+ * every pass and summarised as min/median/p99 in microseconds.
+ *
+ * With -f the threshold line covers the fused threshold and finder
+ * scan pass, and finder_scan only the deferred capstone tests. With -x
+ * frames are bound in place with quirc_begin_external() rather than
+ * copied into the quirc_begin() buffer. With -b the binarised image is
+ * kept as a bit plane, and -j splits each frame into bands worked on by
+ * that many threads.
+ *
+ * With -e each grid is first checked with quirc_check(), and those it
+ * rejects are neither extracted nor decoded, nor written out by -o.
+ *
+ * Decoding reuses one quirc_decoder, as the scanner does; with -a each
+ * decode goes through quirc_decode(), which allocates its own. With -S
+ * payloads are taken a segment at a time from quirc_decode_segments(),
+ * and -v prints the segments.
+ *
+ * -o writes the corners of every grid found on the first pass to a
+ * file, with whether it decoded, and -c compares them with such a file
+ * instead, allowing CORNER_TOLERANCE pixels either way. Between a
+ * floating-point build and one with QUIRC_FIXED_POINT (make compare)
+ * this checks that both find the same grids in the same places. Only
+ * grids which decode in one run or the other count: a false grid can
+ * land anywhere, even far outside the frame, after one rounding goes
+ * the other way.
+ *
+ * Binary PGM (P5, 8-bit) files carry their own size. Headerless 8-bit
+ * frames (*.raw, *.gray) need the size given with -s WxH.
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "quirc_internal.h"
+
+enum
+{
+  STAGE_CHECK = QUIRC_NUM_STAGES,
+  STAGE_EXTRACT,
+  STAGE_DECODE,
+  STAGE_IDENTIFY,
+  NUM_STAGES
+};
+
+static const char *const stage_names[NUM_STAGES] = {
+    [QUIRC_STAGE_PIXELS_SETUP] = "pixels_setup",
+    [QUIRC_STAGE_THRESHOLD] = "threshold",
+    [QUIRC_STAGE_LABEL] = "label",
+    [QUIRC_STAGE_FINDER_SCAN] = "finder_scan",
+    [QUIRC_STAGE_TEST_GROUPING] = "test_grouping",
+    [STAGE_CHECK] = "quirc_check",
+    [STAGE_EXTRACT] = "quirc_extract",
+    [STAGE_DECODE] = "quirc_decode",
+    [STAGE_IDENTIFY] = "begin+end (total)"};
+
+struct samples
+{
+  double *v;
+  int count;
+  int size;
+};
+
+/* Grids may sit this many pixels apart in a comparison */
+#define CORNER_TOLERANCE 2
+
+/* Corners of grid number grid of a frame, as written by -o */
+struct corners
+{
+  char frame[256];
+  int grid;
+  struct quirc_point p[4];
+  int decoded;
+  int seen;
+};
+
+struct frame
+{
+  char name[256];
+  int w;
+  int h;
+  uint8_t *buf;
+};
+
+static struct samples stats[NUM_STAGES];
+static double stage_start[NUM_STAGES];
+
+static double now_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void add_sample(int stage, double us)
+{
+  struct samples *s = &stats[stage];
+
+  if (s->count >= s->size)
+  {
+    s->size = s->size ? s->size * 2 : 1024;
+    s->v = realloc(s->v, s->size * sizeof(s->v[0]));
+    if (!s->v)
+    {
+      perror("realloc");
+      exit(1);
+    }
+  }
+
+  s->v[s->count++] = us;
+}
+
+void quirc_profile_begin(enum quirc_stage stage)
+{
+  stage_start[stage] = now_us();
+}
+
+void quirc_profile_end(enum quirc_stage stage)
+{
+  add_sample(stage, now_us() - stage_start[stage]);
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void print_stats(void)
+{
+  int i;
+
+  printf("%-20s %8s %10s %10s %10s\n",
+         "stage", "samples", "min", "median", "p99");
+
+  for (i = 0; i < NUM_STAGES; i++)
+  {
+    struct samples *s = &stats[i];
+    int p99;
+
+    if (!s->count)
+    {
+      printf("%-20s %8d %10s %10s %10s\n", stage_names[i], 0,
+             "-", "-", "-");
+      continue;
+    }
+
+    qsort(s->v, s->count, sizeof(s->v[0]), cmp_double);
+    p99 = (s->count * 99 + 99) / 100 - 1;
+
+    printf("%-20s %8d %10.1f %10.1f %10.1f\n", stage_names[i], s->count,
+           s->v[0], s->v[s->count / 2], s->v[p99]);
+  }
+}
+
+static int load_corners(const char *path, struct corners **out)
+{
+  FILE *f = fopen(path, "r");
+  struct corners *list = NULL;
+  struct corners c;
+  int count = 0;
+  int size = 0;
+
+  if (!f)
+  {
+    perror(path);
+    return -1;
+  }
+
+  memset(&c, 0, sizeof(c));
+  while (fscanf(f, "%255s %d %d %d %d %d %d %d %d %d %d", c.frame, &c.grid,
+                &c.p[0].x, &c.p[0].y, &c.p[1].x, &c.p[1].y,
+                &c.p[2].x, &c.p[2].y, &c.p[3].x, &c.p[3].y,
+                &c.decoded) == 11)
+  {
+    if (count >= size)
+    {
+      size = size ? size * 2 : 64;
+      list = realloc(list, size * sizeof(list[0]));
+      if (!list)
+      {
+        perror("realloc");
+        exit(1);
+      }
+    }
+
+    list[count++] = c;
+  }
+
+  fclose(f);
+  *out = list;
+  return count;
+}
+
+/* Largest difference in either coordinate of any corner of the given
+ * grid from the reference, or -1 if the reference does not have it.
+ * Sets *decoded to whether the grid decoded in the reference.
+ */
+static int compare_corners(struct corners *ref, int num_ref,
+                           const char *frame, int grid,
+                           const struct quirc_code *code, int *decoded)
+{
+  int i, j;
+
+  for (i = 0; i < num_ref; i++)
+  {
+    int diff = 0;
+
+    if (ref[i].grid != grid || strcmp(ref[i].frame, frame))
+      continue;
+
+    for (j = 0; j < 4; j++)
+    {
+      int dx = abs(code->corners[j].x - ref[i].p[j].x);
+      int dy = abs(code->corners[j].y - ref[i].p[j].y);
+
+      if (dx > diff)
+        diff = dx;
+      if (dy > diff)
+        diff = dy;
+    }
+
+    ref[i].seen = 1;
+    *decoded = ref[i].decoded;
+    return diff;
+  }
+
+  return -1;
+}
+
+static int has_suffix(const char *name, const char *suffix)
+{
+  size_t n = strlen(name);
+  size_t m = strlen(suffix);
+
+  return n > m && !strcmp(name + n - m, suffix);
+}
+
+static int read_pgm_token(FILE *f)
+{
+  int c;
+  int v = 0;
+
+  do
+  {
+    c = fgetc(f);
+    if (c == '#')
+      while (c != '\n' && c != EOF)
+        c = fgetc(f);
+  } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+
+  if (c < '0' || c > '9')
+    return -1;
+
+  while (c >= '0' && c <= '9')
+  {
+    v = v * 10 + c - '0';
+    c = fgetc(f);
+  }
+
+  return v;
+}
+
+static int load_frame(const char *path, struct frame *fr,
+                      int raw_w, int raw_h)
+{
+  FILE *f = fopen(path, "rb");
+  size_t len;
+
+  if (!f)
+  {
+    perror(path);
+    return -1;
+  }
+
+  if (has_suffix(path, ".pgm"))
+  {
+    int maxval;
+
+    if (fgetc(f) != 'P' || fgetc(f) != '5')
+    {
+      fprintf(stderr, "%s: not a binary PGM\n", path);
+      fclose(f);
+      return -1;
+    }
+
+    fr->w = read_pgm_token(f);
+    fr->h = read_pgm_token(f);
+    maxval = read_pgm_token(f);
+    if (fr->w <= 0 || fr->h <= 0 || maxval <= 0 || maxval > 255)
+    {
+      fprintf(stderr, "%s: unsupported PGM header\n", path);
+      fclose(f);
+      return -1;
+    }
+  }
+  else
+  {
+    fr->w = raw_w;
+    fr->h = raw_h;
+  }
+
+  len = (size_t)fr->w * fr->h;
+  fr->buf = malloc(len);
+  if (!fr->buf || fread(fr->buf, 1, len, f) != len)
+  {
+    fprintf(stderr, "%s: short read\n", path);
+    free(fr->buf);
+    fclose(f);
+    return -1;
+  }
+
+  fclose(f);
+  return 0;
+}
+
+static int cmp_frame(const void *a, const void *b)
+{
+  return strcmp(((const struct frame *)a)->name,
+                ((const struct frame *)b)->name);
+}
+
+static int load_dir(const char *dir, struct frame **frames_ret,
+                    int raw_w, int raw_h)
+{
+  DIR *d = opendir(dir);
+  struct dirent *ent;
+  struct frame *frames = NULL;
+  int count = 0;
+
+  if (!d)
+  {
+    perror(dir);
+    return -1;
+  }
+
+  while ((ent = readdir(d)))
+  {
+    char path[1024];
+    struct frame fr;
+    int is_raw = has_suffix(ent->d_name, ".raw") ||
+                 has_suffix(ent->d_name, ".gray");
+
+    if (!has_suffix(ent->d_name, ".pgm") && !is_raw)
+      continue;
+
+    if (is_raw && (raw_w <= 0 || raw_h <= 0))
+    {
+      fprintf(stderr, "%s: raw frame needs -s WxH\n", ent->d_name);
+      continue;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+    memset(&fr, 0, sizeof(fr));
+    snprintf(fr.name, sizeof(fr.name), "%s", ent->d_name);
+
+    if (load_frame(path, &fr, raw_w, raw_h) < 0)
+      continue;
+
+    frames = realloc(frames, (count + 1) * sizeof(*frames));
+    if (!frames)
+    {
+      perror("realloc");
+      exit(1);
+    }
+    frames[count++] = fr;
+  }
+
+  closedir(d);
+  qsort(frames, count, sizeof(*frames), cmp_frame);
+  *frames_ret = frames;
+  return count;
+}
+
+/* Prints a segment under its grid, when given its number to count up */
+static void print_segment(void *arg, const struct quirc_segment *seg)
+{
+  int *n = arg;
+
+  if (!n)
+    return;
+
+  if (seg->data_type == QUIRC_DATA_TYPE_ECI)
+    printf("  segment %d: ECI %u\n", (*n)++, (unsigned)seg->eci);
+  else
+    printf("  segment %d: type %d, %d bytes: %s\n", (*n)++,
+           seg->data_type, seg->len, seg->data);
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr,
+          "usage: %s [-n iterations] [-s WxH] [-t method] [-f] [-l] [-b] [-x] [-j threads] [-r method] [-e] [-a | -S] [-o file | -c file] [-v] "
+          "<frame dir>\n"
+          "\n"
+          "  -n N       process every frame N times (default 10)\n"
+          "  -s WxH     size of headerless *.raw / *.gray frames\n"
+          "  -t method  threshold method: serpentine (default) or box\n"
+          "  -f         fuse thresholding and finder scan into one pass\n"
+          "  -l         label regions from row runs instead of flood fill\n"
+          "  -b         keep the binarised image at one bit per pixel\n"
+          "  -x         bind frames in place instead of copying them\n"
+          "  -j N       work on N bands of each frame at once\n"
+          "  -r method  grid refinement: jiggle (default) or fit\n"
+          "  -e         reject grids by their format information first\n"
+          "  -a         allocate scratch space on every decode\n"
+          "  -S         decode payloads segment by segment\n"
+          "  -o file    write the corners of each grid found to file\n"
+          "  -c file    compare the corners of each grid found with file\n"
+          "  -v         print each decoded payload on the first pass\n",
+          prog);
+}
+
+int main(int argc, char **argv)
+{
+  struct quirc *q;
+  struct quirc_decoder *decoder = NULL;
+  struct frame *frames;
+  int num_frames;
+  int iterations = 10;
+  int raw_w = 0, raw_h = 0;
+  int verbose = 0;
+  int fused = 0;
+  int external = 0;
+  int runs = 0;
+  int bits = 0;
+  int threads = 1;
+  int allocate = 0;
+  int check = 0;
+  int segments = 0;
+  quirc_threshold_method_t threshold_method = QUIRC_THRESHOLD_SERPENTINE;
+  quirc_refinement_t refinement = QUIRC_REFINE_JIGGLE;
+  int grids = 0, rejected = 0, decoded = 0, frames_hit = 0;
+  int flood_fill_peak = 0;
+  const char *corners_out = NULL;
+  const char *corners_ref = NULL;
+  FILE *out = NULL;
+  struct corners *ref = NULL;
+  int num_ref = 0;
+  int compared = 0, unmatched = 0, beyond = 0, worst = 0;
+  int status = 0;
+  int opt;
+  int it, i;
+
+  while ((opt = getopt(argc, argv, "n:s:t:flbxj:r:eaSo:c:v")) >= 0)
+  {
+    switch (opt)
+    {
+    case 'n':
+      iterations = atoi(optarg);
+      break;
+
+    case 's':
+      if (sscanf(optarg, "%dx%d", &raw_w, &raw_h) != 2)
+      {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+
+    case 't':
+      if (!strcmp(optarg, "serpentine"))
+        threshold_method = QUIRC_THRESHOLD_SERPENTINE;
+      else if (!strcmp(optarg, "box"))
+        threshold_method = QUIRC_THRESHOLD_BOX;
+      else
+      {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+
+    case 'f':
+      fused = 1;
+      break;
+
+    case 'l':
+      runs = 1;
+      break;
+
+    case 'b':
+      bits = 1;
+      break;
+
+    case 'x':
+      external = 1;
+      break;
+
+    case 'j':
+      threads = atoi(optarg);
+      break;
+
+    case 'r':
+      if (!strcmp(optarg, "jiggle"))
+        refinement = QUIRC_REFINE_JIGGLE;
+      else if (!strcmp(optarg, "fit"))
+        refinement = QUIRC_REFINE_FIT;
+      else
+      {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+
+    case 'e':
+      check = 1;
+      break;
+
+    case 'a':
+      allocate = 1;
+      break;
+
+    case 'S':
+      segments = 1;
+      break;
+
+    case 'o':
+      corners_out = optarg;
+      break;
+
+    case 'c':
+      corners_ref = optarg;
+      break;
+
+    case 'v':
+      verbose = 1;
+      break;
+
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (optind + 1 != argc || iterations < 1)
+  {
+    usage(argv[0]);
+    return 2;
+  }
+
+  num_frames = load_dir(argv[optind], &frames, raw_w, raw_h);
+  if (num_frames <= 0)
+  {
+    fprintf(stderr, "%s: no frames found\n", argv[optind]);
+    return 1;
+  }
+
+  if (corners_out)
+  {
+    out = fopen(corners_out, "w");
+    if (!out)
+    {
+      perror(corners_out);
+      return 1;
+    }
+  }
+
+  if (corners_ref)
+  {
+    num_ref = load_corners(corners_ref, &ref);
+    if (num_ref < 0)
+      return 1;
+  }
+
+  q = quirc_new();
+  if (!q)
+  {
+    perror("quirc_new");
+    return 1;
+  }
+
+  if (allocate && segments)
+  {
+    usage(argv[0]);
+    return 2;
+  }
+
+  if (!allocate)
+  {
+    decoder = quirc_decoder_new();
+    if (!decoder)
+    {
+      perror("quirc_decoder_new");
+      return 1;
+    }
+  }
+
+  quirc_set_threshold_method(q, threshold_method);
+  quirc_set_fused_scan(q, fused);
+  quirc_set_labelling(q, runs ? QUIRC_LABEL_RUNS : QUIRC_LABEL_FLOOD_FILL);
+  quirc_set_bit_plane(q, bits);
+  quirc_set_refinement(q, refinement);
+  if (quirc_set_threads(q, threads) < 0)
+  {
+    fprintf(stderr, "quirc_set_threads failed\n");
+    return 1;
+  }
+
+  for (it = 0; it < iterations; it++)
+  {
+    for (i = 0; i < num_frames; i++)
+    {
+      struct frame *fr = &frames[i];
+      int w, h;
+      int count;
+      int hit = 0;
+      int j;
+      uint8_t *image;
+      double t;
+
+      if ((q->w != fr->w || q->h != fr->h) &&
+          quirc_resize(q, fr->w, fr->h) < 0)
+      {
+        fprintf(stderr, "%s: quirc_resize failed\n", fr->name);
+        return 1;
+      }
+
+      t = now_us();
+      if (external)
+      {
+        quirc_begin_external(q, fr->buf, fr->w);
+      }
+      else
+      {
+        image = quirc_begin(q, &w, &h);
+        memcpy(image, fr->buf, (size_t)w * h);
+      }
+      quirc_end(q);
+      add_sample(STAGE_IDENTIFY, now_us() - t);
+
+      if (quirc_flood_fill_peak(q) > flood_fill_peak)
+        flood_fill_peak = quirc_flood_fill_peak(q);
+
+      count = quirc_count(q);
+      for (j = 0; j < count; j++)
+      {
+        static struct quirc_code code;
+        static struct quirc_data data;
+        quirc_decode_error_t err;
+        int segment = 0;
+
+        if (check)
+        {
+          t = now_us();
+          err = quirc_check(q, j);
+          add_sample(STAGE_CHECK, now_us() - t);
+
+          if (err)
+          {
+            if (!it)
+            {
+              grids++;
+              rejected++;
+              if (verbose)
+                printf("%s: grid %d: rejected: %s\n", fr->name, j,
+                       quirc_strerror(err));
+            }
+            continue;
+          }
+        }
+
+        t = now_us();
+        quirc_extract(q, j, &code);
+        add_sample(STAGE_EXTRACT, now_us() - t);
+
+        if (segments && verbose && !it)
+          printf("%s: grid %d:\n", fr->name, j);
+
+        t = now_us();
+        if (segments)
+          err = quirc_decode_segments(decoder, &code, print_segment,
+                                      verbose && !it ? &segment : NULL);
+        else if (decoder)
+          err = quirc_decode_with(decoder, &code, &data);
+        else
+          err = quirc_decode(&code, &data);
+        add_sample(STAGE_DECODE, now_us() - t);
+
+        if (it)
+          continue;
+
+        grids++;
+        if (out)
+          fprintf(out, "%s %d %d %d %d %d %d %d %d %d %d\n", fr->name, j,
+                  code.corners[0].x, code.corners[0].y,
+                  code.corners[1].x, code.corners[1].y,
+                  code.corners[2].x, code.corners[2].y,
+                  code.corners[3].x, code.corners[3].y, !err);
+
+        if (corners_ref)
+        {
+          int ref_decoded = 0;
+          int diff = compare_corners(ref, num_ref, fr->name, j, &code,
+                                     &ref_decoded);
+
+          if (diff < 0)
+          {
+            if (!err)
+              unmatched++;
+          }
+          else if (ref_decoded || !err)
+          {
+            compared++;
+            if (diff > worst)
+              worst = diff;
+            if (diff > CORNER_TOLERANCE)
+              beyond++;
+          }
+        }
+
+        if (!err)
+        {
+          decoded++;
+          hit = 1;
+        }
+
+        if (verbose && segments)
+        {
+          if (err)
+            printf("  %s\n", quirc_strerror(err));
+        }
+        else if (verbose)
+        {
+          if (err)
+            printf("%s: grid %d: %s\n", fr->name, j,
+                   quirc_strerror(err));
+          else
+            printf("%s: grid %d: v%d: %s\n", fr->name, j,
+                   data.version, data.payload);
+        }
+      }
+
+      if (!it && hit)
+        frames_hit++;
+    }
+  }
+
+  printf("frames: %d, iterations: %d\n", num_frames, iterations);
+  printf("grids: %d, decoded: %d, frames with a decode: %d/%d\n",
+         grids, decoded, frames_hit, num_frames);
+  if (check)
+    printf("rejected before extraction: %d\n", rejected);
+  printf("\n");
+  print_stats();
+  printf("\nflood fill stack peak: %d spans\n", flood_fill_peak);
+
+  if (out)
+    fclose(out);
+
+  if (corners_ref)
+  {
+    for (i = 0; i < num_ref; i++)
+      if (!ref[i].seen && ref[i].decoded)
+        unmatched++;
+
+    printf("corners: %d grids compared, %d unmatched, "
+           "largest difference %d px, %d beyond %d px\n",
+           compared, unmatched, worst, beyond, CORNER_TOLERANCE);
+    free(ref);
+
+    if (unmatched || beyond)
+      status = 1;
+  }
+
+  quirc_decoder_destroy(decoder);
+  quirc_destroy(q);
+  for (i = 0; i < num_frames; i++)
+    free(frames[i].buf);
+  free(frames);
+
+  return status;
+}
@@ -20,8 +20,12 @@
 #include <math.h>
 
 #include "fmath.h"
-#include "collections.h"
 #include "quirc_internal.h"
+#include <Arduino.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
 
 /************************************************************************
  * Linear algebra routines
@@ -41,9 +45,12 @@ static int line_intersect(const struct quirc_point *p0,
   int c = -(q1->y - q0->y);
   int d = q1->x - q0->x;
 
-  /* e and f are dot products of the respective vectors with p and q */
-  int e = a * p1->x + b * p1->y;
-  int f = c * q1->x + d * q1->y;
+  /* e and f are dot products of the respective vectors with p and q.
+   * Products of three coordinates can overflow 32 bits on an SVGA
+   * frame, so these are worked out in 64.
+   */
+  int64_t e = (int64_t)a * p1->x + (int64_t)b * p1->y;
+  int64_t f = (int64_t)c * q1->x + (int64_t)d * q1->y;
 
   /* Now we need to solve:
      *     [a b] [rx]   [e]
@@ -53,7 +60,7 @@ static int line_intersect(const struct quirc_point *p0,
      *       [ d -b] [e]   [rx]
      * 1/det [-c  a] [f] = [ry]
      */
-  int det = (a * d) - (b * c);
+  int64_t det = ((int64_t)a * d) - ((int64_t)b * c);
 
   if (!det)
     return 0;
@@ -64,9 +71,158 @@ static int line_intersect(const struct quirc_point *p0,
   return 1;
 }
 
+#ifdef QUIRC_FIXED_POINT
+/* Round num / den to a fixed-point number with shift fractional bits */
+static quirc_coord_t fix_ratio(int64_t num, int64_t den, int shift)
+{
+  if (!den)
+    return 0;
+
+  num *= (int64_t)1 << shift;
+  if ((num < 0) != (den < 0))
+    return (num - den / 2) / den;
+
+  return (num + den / 2) / den;
+}
+
+/* The same formulae as the floating-point version below. The corners
+ * are whole pixels, so every numerator and denominator is an exact
+ * 64-bit integer, and each coefficient is rounded just once.
+ */
+static void perspective_setup(quirc_coord_t *c,
+                              const struct quirc_point *rect,
+                              int w, int h)
+{
+  int64_t x0 = rect[0].x;
+  int64_t y0 = rect[0].y;
+  int64_t x1 = rect[1].x;
+  int64_t y1 = rect[1].y;
+  int64_t x2 = rect[2].x;
+  int64_t y2 = rect[2].y;
+  int64_t x3 = rect[3].x;
+  int64_t y3 = rect[3].y;
+
+  int64_t wden = w * (x2 * y3 - x3 * y2 + (x3 - x2) * y1 + x1 * (y2 - y3));
+  int64_t hden = h * (x2 * y3 + x1 * (y2 - y3) - x3 * y2 + (x3 - x2) * y1);
+
+  c[0] = fix_ratio(x1 * (x2 * y3 - x3 * y2) +
+                       x0 * (-x2 * y3 + x3 * y2 + (x2 - x3) * y1) +
+                       x1 * (x3 - x2) * y0,
+                   wden, QUIRC_FIX_SHIFT);
+  c[1] = fix_ratio(-(x0 * (x2 * y3 + x1 * (y2 - y3) - x2 * y1) -
+                     x1 * x3 * y2 + x2 * x3 * y1 +
+                     (x1 * x3 - x2 * x3) * y0),
+                   hden, QUIRC_FIX_SHIFT);
+  c[2] = QUIRC_INT(x0);
+  c[3] = fix_ratio(y0 * (x1 * (y3 - y2) - x2 * y3 + x3 * y2) +
+                       y1 * (x2 * y3 - x3 * y2) + x0 * y1 * (y2 - y3),
+                   wden, QUIRC_FIX_SHIFT);
+  c[4] = fix_ratio(x0 * (y1 * y3 - y2 * y3) + x1 * y2 * y3 - x2 * y1 * y3 +
+                       y0 * (x3 * y2 - x1 * y2 + (x2 - x3) * y1),
+                   hden, QUIRC_FIX_SHIFT);
+  c[5] = QUIRC_INT(y0);
+  c[6] = fix_ratio(x1 * (y3 - y2) + x0 * (y2 - y3) + (x2 - x3) * y1 +
+                       (x3 - x2) * y0,
+                   wden, QUIRC_DEN_SHIFT);
+  c[7] = fix_ratio(-x2 * y3 + x1 * y3 + x3 * y2 + x0 * (y1 - y2) -
+                       x3 * y1 + (x2 - x1) * y0,
+                   hden, QUIRC_DEN_SHIFT);
+}
+
+/* Both quotients are of Q16.16 numbers, so integer division leaves
+ * the pixel, truncated like fast_roundf() does.
+ */
+static void perspective_map(const quirc_coord_t *c,
+                            quirc_coord_t u, quirc_coord_t v,
+                            struct quirc_point *ret)
+{
+  int32_t den = (int32_t)(((int64_t)c[6] * u + (int64_t)c[7] * v) >>
+                          QUIRC_DEN_SHIFT) +
+                QUIRC_INT(1);
+  int32_t x = (int32_t)(((int64_t)c[0] * u + (int64_t)c[1] * v) >>
+                        QUIRC_FIX_SHIFT) +
+              c[2];
+  int32_t y = (int32_t)(((int64_t)c[3] * u + (int64_t)c[4] * v) >>
+                        QUIRC_FIX_SHIFT) +
+              c[5];
+
+  /* On the horizon: anywhere far outside the image will do */
+  if (!den)
+    den = 1;
+
+  ret->x = x / den;
+  ret->y = y / den;
+}
+
+/* Products of two coefficients are Q32 here, those with c[6] or c[7]
+ * once shifted down to match.
+ */
+static void perspective_unmap(const quirc_coord_t *c,
+                              const struct quirc_point *in,
+                              quirc_coord_t *u, quirc_coord_t *v)
+{
+  const int shift = QUIRC_DEN_SHIFT - QUIRC_FIX_SHIFT;
+  int64_t x = in->x;
+  int64_t y = in->y;
+  int64_t yf = QUIRC_INT(y) - (int64_t)c[5];
+  int64_t c07 = ((int64_t)c[0] * c[7]) >> shift;
+  int64_t c16 = ((int64_t)c[1] * c[6]) >> shift;
+  int64_t c26 = ((int64_t)c[2] * c[6]) >> shift;
+  int64_t c27 = ((int64_t)c[2] * c[7]) >> shift;
+  int64_t c37 = ((int64_t)c[3] * c[7]) >> shift;
+  int64_t c46 = ((int64_t)c[4] * c[6]) >> shift;
+  int64_t c56 = ((int64_t)c[5] * c[6]) >> shift;
+  int64_t c57 = ((int64_t)c[5] * c[7]) >> shift;
+  int64_t den = -c07 * y + c16 * y + (c37 - c46) * x +
+                (int64_t)c[0] * c[4] - (int64_t)c[1] * c[3];
+
+  den >>= QUIRC_FIX_SHIFT;
+  if (!den)
+  {
+    *u = 0;
+    *v = 0;
+    return;
+  }
+
+  *u = -((int64_t)c[1] * yf - c27 * y +
+         (c57 - ((int64_t)c[4] << QUIRC_FIX_SHIFT)) * x +
+         (int64_t)c[2] * c[4]) /
+       den;
+  *v = ((int64_t)c[0] * yf - c26 * y +
+        (c56 - ((int64_t)c[3] << QUIRC_FIX_SHIFT)) * x +
+        (int64_t)c[2] * c[3]) /
+       den;
+}
+
+/* A fixed-point map is cheap enough as it is, and would round
+ * differently from a walk, so here the walk is deliberately not one:
+ * it ignores the step and maps each point afresh.
+ */
+struct perspective_walk
+{
+  const quirc_coord_t *c;
+  quirc_coord_t v;
+};
+
+static void perspective_walk_start(struct perspective_walk *w,
+                                   const quirc_coord_t *c, quirc_coord_t v,
+                                   quirc_coord_t step)
+{
+  (void)step;
+  w->c = c;
+  w->v = v;
+}
+
+static void perspective_walk_next(struct perspective_walk *w,
+                                  quirc_coord_t u, struct quirc_point *ret)
+{
+  perspective_map(w->c, u, w->v, ret);
+}
+
+#else
 static void perspective_setup(float *c,
                               const struct quirc_point *rect,
-                              float w, float h)
+                              int w, int h)
 {
   float x0 = rect[0].x;
   float y0 = rect[0].y;
@@ -100,7 +256,7 @@ static void perspective_setup(float *c,
 static void perspective_map(const float *c,
                             float u, float v, struct quirc_point *ret)
 {
-  float den = c[6] * u + c[7] * v + 1.0;
+  float den = c[6] * u + c[7] * v + 1.0f;
   float x = (c[0] * u + c[1] * v + c[2]) / den;
   float y = (c[3] * u + c[4] * v + c[5]) / den;
 
@@ -123,17 +279,126 @@ static void perspective_unmap(const float *c,
        den;
 }
 
+/* Walking the transform along a line of constant v. The numerators and
+ * the denominator of the next point are stepped by additions only, and
+ * one reciprocal per point stands in for perspective_map()'s two
+ * divisions. The sums are recomputed every PERSPECTIVE_WALK_SPAN points
+ * so that rounding cannot build up.
+ *
+ * A walk rounds differently from perspective_map(), by far less than
+ * PERSPECTIVE_WALK_GUARD for images up to 2048 pixels across. Points
+ * whose coordinates fall that close to a whole number, which is where
+ * the two could pick different pixels, are mapped again the slow way,
+ * so the result is always the same as perspective_map()'s.
+ */
+#define PERSPECTIVE_WALK_SPAN 16
+#define PERSPECTIVE_WALK_GUARD (1.0f / 64)
+
+struct perspective_walk
+{
+  const float *c;
+  float v;
+
+  /* Numerators and denominator at the next point, and their steps */
+  float x, y, den;
+  float dx, dy, dden;
+
+  /* Points until the sums are recomputed */
+  int left;
+};
+
+static void perspective_walk_start(struct perspective_walk *w,
+                                   const float *c, float v, float step)
+{
+  w->c = c;
+  w->v = v;
+  w->dx = c[0] * step;
+  w->dy = c[3] * step;
+  w->dden = c[6] * step;
+  w->left = 0;
+}
+
+static int perspective_walk_near(float x)
+{
+  float f;
+
+  if (x <= -4096.0f || x >= 4096.0f)
+    return 1;
+
+  f = x - (float)(int)x;
+  if (f < 0)
+    f = -f;
+
+  return f < PERSPECTIVE_WALK_GUARD || f > 1.0f - PERSPECTIVE_WALK_GUARD;
+}
+
+/* Map the next point of the walk, which is at u, and step past it. */
+static void perspective_walk_next(struct perspective_walk *w, float u,
+                                  struct quirc_point *ret)
+{
+  const float *c = w->c;
+  float r, x, y;
+
+  if (!w->left--)
+  {
+    w->x = c[0] * u + c[1] * w->v + c[2];
+    w->y = c[3] * u + c[4] * w->v + c[5];
+    w->den = c[6] * u + c[7] * w->v + 1.0f;
+    w->left = PERSPECTIVE_WALK_SPAN - 1;
+  }
+
+  r = 1.0f / w->den;
+  x = w->x * r;
+  y = w->y * r;
+
+  if (w->den < 0.5f || w->den > 2.0f ||
+      perspective_walk_near(x) || perspective_walk_near(y))
+  {
+    perspective_map(c, u, w->v, ret);
+  }
+  else
+  {
+    ret->x = fast_roundf(x);
+    ret->y = fast_roundf(y);
+  }
+
+  w->x += w->dx;
+  w->y += w->dy;
+  w->den += w->dden;
+}
+#endif
+
 /************************************************************************
  * Span-based floodfill routine
  */
 
 typedef void (*span_func_t)(void *user_data, int y, int left, int right);
 
-typedef struct xylf
+/* Push a pending span onto q's flood fill stack, doubling the stack if
+ * it is full. Returns -1 if it could not be grown.
+ */
+static int flood_fill_push(struct quirc *q, size_t *len, const xylf_t *context)
 {
-  int16_t x, y, l, r;
-} __attribute__((aligned(8)))
-xylf_t;
+  if (*len >= q->flood_fill_size)
+  {
+    size_t size = q->flood_fill_size * 2;
+    xylf_t *stack = ps_malloc(size * sizeof(*stack));
+
+    if (!stack)
+      return -1;
+
+    memcpy(stack, q->flood_fill_stack, *len * sizeof(*stack));
+    free(q->flood_fill_stack);
+    q->flood_fill_stack = stack;
+    q->flood_fill_size = size;
+  }
+
+  q->flood_fill_stack[(*len)++] = *context;
+  if (*len > q->flood_fill_peak)
+    q->flood_fill_peak = *len;
+
+  return 0;
+}
 
 //计算该区域的面积，from是像素颜色，to是区块标号，user_data是申请的区块结构体，func是计算面积的函数
 static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
@@ -142,10 +407,11 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
 {
   (void)depth; // unused
 
-  lifo_t lifo;
-  size_t lifo_len;
-  lifo_alloc_all(&lifo, &lifo_len, sizeof(xylf_t));
-  //late in first out. 申请xylf_t的lifo，一次申请完，长度存储在lifo_len中
+  /* Spans waiting to have their other neighbours scanned live on
+   * q->flood_fill_stack, which is allocated by quirc_resize() and kept
+   * between fills.
+   */
+  size_t len = 0;
 
   for (;;)
   {
@@ -169,91 +435,365 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
 
     for (;;)
     {
-      if (lifo_size(&lifo) < lifo_len)
-      { //栈中的数量
-        /* Seed new flood-fills */
-        if (y > 0)
-        { //查找上一行有没有在同一区域的点
-          row = q->pixels + (y - 1) * q->w;
-
-          bool recurse = false;
-          for (i = left; i <= right; i++)
-            if (row[i] == from)
-            { //相同区域，则入栈原来的区块
-              xylf_t context;
-              context.x = x;
-              context.y = y;
-              context.l = left;
-              context.r = right;
-              lifo_enqueue(&lifo, &context);
-              //mp_printf(&mp_plat_print, "#x=%x,y=%d;x1=%d,y1=%d\n",x,y,i,y-1);
-              x = i;
-              y = y - 1;
-              recurse = true;
-              break;
-            }
-          if (recurse)
+      xylf_t context;
+      int next_x = 0;
+      int next_y = -1;
+
+      /* Seed new flood-fills */
+      if (y > 0)
+      { //查找上一行有没有在同一区域的点
+        row = q->pixels + (y - 1) * q->w;
+
+        for (i = left; i <= right; i++)
+          if (row[i] == from)
+          {
+            next_x = i;
+            next_y = y - 1;
             break;
-        }
-        //查找下一行有没有在同一区域的点
-        if (y < q->h - 1)
-        {
-          row = q->pixels + (y + 1) * q->w;
-
-          bool recurse = false;
-          for (i = left; i <= right; i++)
-            if (row[i] == from)
-            {
-              xylf_t context;
-              context.x = x;
-              context.y = y;
-              context.l = left;
-              context.r = right;
-              lifo_enqueue(&lifo, &context);
-              //mp_printf(&mp_plat_print, "#x=%x,y=%d;x1=%d,y1=%d\n",x,y,i,y+1);
-              x = i;
-              y = y + 1;
-              recurse = true;
-              break;
-            }
-          if (recurse)
+          }
+      }
+      //查找下一行有没有在同一区域的点
+      if (next_y < 0 && y < q->h - 1)
+      {
+        row = q->pixels + (y + 1) * q->w;
+
+        for (i = left; i <= right; i++)
+          if (row[i] == from)
+          {
+            next_x = i;
+            next_y = y + 1;
             break;
-        }
+          }
       }
 
-      if (!lifo_size(&lifo))
-      {
-        lifo_free(&lifo); //如果最起始为止就没找到，那么返回
-        return;
+      if (next_y >= 0)
+      { //相同区域，则入栈原来的区块
+        context.x = x;
+        context.y = y;
+        context.l = left;
+        context.r = right;
+
+        /* If the stack cannot grow, carry on from the spans already
+         * on it; the rest of the region is left unfilled.
+         */
+        if (!flood_fill_push(q, &len, &context))
+        {
+          x = next_x;
+          y = next_y;
+          break;
+        }
       }
+
+      if (!len)
+        return; //如果最起始为止就没找到，那么返回
+
       //本次迭代，往上，往下找边界（相同颜色像素点），直到找不到为止
       //找到边界后，出栈上层像素点，回退回去
-      xylf_t context;
-      lifo_dequeue(&lifo, &context); //这里存疑，如果都没有的话，dequeue就会反向溢出吧。。
+      context = q->flood_fill_stack[--len];
       x = context.x;
       y = context.y;
       left = context.l;
       right = context.r;
-      //mp_printf(&mp_plat_print, "#deq: x=%x,y=%d\n",x,y);
     } //找到相同from，break到这外面
   }
 }
 
+/************************************************************************
+ * 1-bpp pixel plane
+ *
+ * With quirc_set_bit_plane() the binarised image is kept at one bit per
+ * pixel, most significant bit first, so that it is small enough for
+ * internal RAM. Each row is binarised into a scratch row of bytes and
+ * packed straight away. Region labels cannot be stored in it, which is
+ * why regions are then labelled from the runs.
+ */
+
+static int bits_begin(struct quirc *q)
+{
+  const int stride = (q->image_w + 31) >> 5;
+
+  if (!q->bits)
+  {
+    q->bits = heap_caps_malloc(stride * q->image_h * sizeof(*q->bits),
+                               MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!q->bits)
+      return -1;
+  }
+
+  if (!q->bit_row)
+  {
+    q->bit_row = heap_caps_malloc(q->image_w * sizeof(*q->bit_row),
+                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!q->bit_row)
+      return -1;
+  }
+
+  /* A region is packed like the byte image, rows its own width apart */
+  q->bit_stride = (q->w + 31) >> 5;
+  return 0;
+}
+
+static void bits_pack_row(struct quirc *q, int y)
+{
+  const quirc_pixel_t *src = q->bit_row;
+  uint32_t *dst = q->bits + y * q->bit_stride;
+  int x;
+
+  for (x = 0; x < q->w; x += 32)
+  {
+    const int n = q->w - x < 32 ? q->w - x : 32;
+    uint32_t word = 0;
+    int i = 0;
+
+#if QUIRC_MAX_REGIONS < UINT8_MAX && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    /* Eight pixels of 0 or 1 at a time: the multiply gathers bit 0 of
+     * each byte, first pixel highest, into the top byte.
+     */
+    for (; i + 8 <= n; i += 8)
+    {
+      uint64_t v;
+
+      memcpy(&v, src + x + i, sizeof(v));
+      word |= (uint32_t)((v * 0x8040201008040201ull) >> 56) << (24 - i);
+    }
+#endif
+
+    for (; i < n; i++)
+      word |= (uint32_t)src[x + i] << (31 - i);
+
+    *dst++ = word;
+  }
+}
+
+/* Non-zero if pixel (x, y), which must lie within the image, is dark. */
+static inline int pixel_dark(const struct quirc *q, int x, int y)
+{
+  if (q->use_bits)
+    return (q->bits[y * q->bit_stride + (x >> 5)] >> (31 - (x & 31))) & 1;
+
+  return q->pixels[y * q->w + x] != QUIRC_PIXEL_WHITE;
+}
+
+/* Return the first x from start up to w at which a row of the bit plane
+ * is not value. Whole words are skipped until one differs, and the
+ * position within it is found by counting leading zeros.
+ */
+static int bit_run_end(const uint32_t *row, int x, int w, int value)
+{
+  const uint32_t flip = value ? ~0u : 0;
+  uint32_t word;
+
+  if (x >= w)
+    return w;
+
+  word = (row[x >> 5] ^ flip) & (~0u >> (x & 31));
+  x &= ~31;
+
+  while (!word)
+  {
+    x += 32;
+    if (x >= w)
+      return w;
+    word = row[x >> 5] ^ flip;
+  }
+
+  /* Bits past the end of the row are clear */
+  x += __builtin_clz(word);
+  return x < w ? x : w;
+}
+
 /************************************************************************
  * Adaptive thresholding
  */
 
-#define THRESHOLD_S_MIN 1
-#define THRESHOLD_S_DEN 8
-#define THRESHOLD_T 5
+/* Binarise one row for the serpentine filter. row_average[x] holds the
+ * sum of both moving averages, i.e. roughly 2 * threshold_s times the
+ * local mean, and a pixel is black if
+ *
+ *     row[x] < row_average[x] * (100 - THRESHOLD_T) / den
+ *
+ * with den = 200 * threshold_s. The quotient is never formed: for
+ * non-negative integers p < n / d (rounded down) exactly when
+ * (p + 1) * d <= n, which leaves two multiplies by constants and a
+ * compare per pixel and vectorises cleanly.
+ */
+#if !defined(QUIRC_NO_SIMD) && QUIRC_MAX_REGIONS < UINT8_MAX && \
+    defined(__AVX2__)
+#include <immintrin.h>
 
-static void threshold(struct quirc *q)
+static int binarise_row_simd(quirc_pixel_t *dst, const uint8_t *src,
+                             const uint32_t *row_average, int w, int den)
 {
-  int x, y;
-  int avg_w = 0;
-  int avg_u = 0;
-  int threshold_s = q->w / THRESHOLD_S_DEN;
-  quirc_pixel_t *row = q->pixels;
+  const __m256i vden = _mm256_set1_epi32(den);
+  const __m256i vnum = _mm256_set1_epi32(100 - THRESHOLD_T);
+  const __m256i one = _mm256_set1_epi32(1);
+  int x;
+
+  for (x = 0; x + 16 <= w; x += 16)
+  {
+    const __m128i px = _mm_loadu_si128((const __m128i *)(src + x));
+    __m256i white[2];
+    __m256i packed;
+    int k;
+
+    for (k = 0; k < 2; k++)
+    {
+      const __m256i p = _mm256_cvtepu8_epi32(_mm_srli_si128(px, k * 8));
+      const __m256i avg =
+          _mm256_loadu_si256((const __m256i *)(row_average + x + k * 8));
+
+      white[k] = _mm256_cmpgt_epi32(
+          _mm256_mullo_epi32(_mm256_add_epi32(p, one), vden),
+          _mm256_mullo_epi32(avg, vnum));
+    }
+
+    /* 32 -> 16 bit packing works per 128-bit lane; put the lanes back
+     * in pixel order before the final 16 -> 8 bit pack.
+     */
+    packed = _mm256_permute4x64_epi64(
+        _mm256_packs_epi32(white[0], white[1]), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128((__m128i *)(dst + x),
+                     _mm_andnot_si128(
+                         _mm_packs_epi16(_mm256_castsi256_si128(packed),
+                                         _mm256_extracti128_si256(packed, 1)),
+                         _mm_set1_epi8(QUIRC_PIXEL_BLACK)));
+  }
+
+  return x;
+}
+#elif !defined(QUIRC_NO_SIMD) && QUIRC_MAX_REGIONS < UINT8_MAX && \
+    defined(__SSE2__)
+#include <emmintrin.h>
+
+/* SSE2 has no 32-bit low multiply; combine the even and odd lanes of
+ * two 32x32->64 multiplies instead.
+ */
+static inline __m128i mullo_epi32(__m128i a, __m128i b)
+{
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32),
+                                    _mm_srli_epi64(b, 32));
+
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* Four pixels at a time: all-ones in the lanes which are white */
+static inline __m128i threshold_cmp(__m128i p, const uint32_t *avg,
+                                    __m128i vden, __m128i vnum)
+{
+  return _mm_cmpgt_epi32(
+      mullo_epi32(_mm_add_epi32(p, _mm_set1_epi32(1)), vden),
+      mullo_epi32(_mm_loadu_si128((const __m128i *)avg), vnum));
+}
+
+static int binarise_row_simd(quirc_pixel_t *dst, const uint8_t *src,
+                             const uint32_t *row_average, int w, int den)
+{
+  const __m128i vden = _mm_set1_epi32(den);
+  const __m128i vnum = _mm_set1_epi32(100 - THRESHOLD_T);
+  const __m128i zero = _mm_setzero_si128();
+  int x;
+
+  for (x = 0; x + 16 <= w; x += 16)
+  {
+    const __m128i px = _mm_loadu_si128((const __m128i *)(src + x));
+    const __m128i lo = _mm_unpacklo_epi8(px, zero);
+    const __m128i hi = _mm_unpackhi_epi8(px, zero);
+    const __m128i white0 = threshold_cmp(
+        _mm_unpacklo_epi16(lo, zero), row_average + x, vden, vnum);
+    const __m128i white1 = threshold_cmp(
+        _mm_unpackhi_epi16(lo, zero), row_average + x + 4, vden, vnum);
+    const __m128i white2 = threshold_cmp(
+        _mm_unpacklo_epi16(hi, zero), row_average + x + 8, vden, vnum);
+    const __m128i white3 = threshold_cmp(
+        _mm_unpackhi_epi16(hi, zero), row_average + x + 12, vden, vnum);
+
+    _mm_storeu_si128((__m128i *)(dst + x),
+                     _mm_andnot_si128(
+                         _mm_packs_epi16(_mm_packs_epi32(white0, white1),
+                                         _mm_packs_epi32(white2, white3)),
+                         _mm_set1_epi8(QUIRC_PIXEL_BLACK)));
+  }
+
+  return x;
+}
+#else
+/* Everything else, including the ESP32-S3 (whose PIE vector unit the
+ * Arduino toolchain only exposes through hand-written assembly), uses
+ * the scalar loop in binarise_row().
+ */
+static int binarise_row_simd(quirc_pixel_t *dst, const uint8_t *src,
+                             const uint32_t *row_average, int w, int den)
+{
+  return 0;
+}
+#endif
+
+static void binarise_row(quirc_pixel_t *dst, const uint8_t *src,
+                         const uint32_t *row_average, int w, int den)
+{
+  int x = binarise_row_simd(dst, src, row_average, w, den);
+
+  for (; x < w; x++)
+  {
+    if ((uint32_t)(src[x] + 1) * den <=
+        row_average[x] * (100 - THRESHOLD_T))
+      dst[x] = QUIRC_PIXEL_BLACK;
+    else
+      dst[x] = QUIRC_PIXEL_WHITE;
+  }
+}
+
+/* Both filters binarise one row at a time, reading grey levels from
+ * q->source and writing q->pixels (which is the same buffer unless
+ * quirc_pixel_t is wider than a byte or the image is external), or the
+ * scratch row of the bit plane. This lets quirc_end() interleave
+ * thresholding with the finder pattern scan.
+ */
+struct threshold_state
+{
+  /* Serpentine filter */
+  int threshold_s;
+  uint32_t decay;
+  uint32_t avg_fwd;
+  uint32_t avg_rev;
+
+  /* Box filter */
+  int r;
+  uint32_t recip;
+};
+
+static quirc_pixel_t *threshold_dst(struct quirc *q, int y)
+{
+  return q->use_bits ? q->bit_row : q->pixels + y * q->w;
+}
+
+/* Advance the serpentine averages over row y without binarising it. */
+static void serpentine_skip(struct quirc *q, struct threshold_state *ts,
+                            int y)
+{
+  const uint8_t *src = q->source + y * q->source_stride;
+  uint32_t avg_fwd = ts->avg_fwd;
+  uint32_t avg_rev = ts->avg_rev;
+  int x;
+
+  for (x = 0; x < q->w; x++)
+  {
+    avg_fwd = (((uint64_t)avg_fwd * ts->decay) >> 32) + src[x];
+    avg_rev = (((uint64_t)avg_rev * ts->decay) >> 32) + src[q->w - 1 - x];
+  }
+
+  ts->avg_fwd = avg_rev;
+  ts->avg_rev = avg_fwd;
+}
+
+static void serpentine_begin(struct quirc *q, struct threshold_state *ts,
+                             int y0)
+{
+  int threshold_s = q->image_w / THRESHOLD_S_DEN;
+  int y;
 
   /*
      * Ensure a sane, non-zero value for threshold_s.
@@ -264,54 +804,479 @@ static void threshold(struct quirc *q)
   if (threshold_s < THRESHOLD_S_MIN)
     threshold_s = THRESHOLD_S_MIN;
 
+  ts->threshold_s = threshold_s;
+  ts->avg_fwd = 0;
+  ts->avg_rev = 0;
+
+  /* Each moving average step is avg * (threshold_s - 1) / threshold_s.
+   * With decay = ceil(2^32 * (threshold_s - 1) / threshold_s) this is
+   * (avg * decay) >> 32, exactly, for any avg below 2^32 / threshold_s;
+   * the averages never exceed 256 * threshold_s.
+   */
+  ts->decay = ((((uint64_t)threshold_s - 1) << 32) + threshold_s - 1) /
+              threshold_s;
+
+  /* The averages carry over from row to row, so a band starting further
+   * down warms them up on the rows just above it. An image width later
+   * the starting values count for less than e^-8 of the result.
+   */
+  for (y = y0 > THRESHOLD_HALO ? y0 - THRESHOLD_HALO : 0; y < y0; y++)
+    serpentine_skip(q, ts, y);
+}
+
+static void serpentine_row(struct quirc *q, struct threshold_state *ts,
+                           int y)
+{
+  const uint8_t *src = q->source + y * q->source_stride;
+  uint32_t *row_average = q->threshold_sums;
+  const uint32_t decay = ts->decay;
+  uint32_t avg_fwd = ts->avg_fwd;
+  uint32_t avg_rev = ts->avg_rev;
+  int x;
+
+  memset(row_average, 0, q->w * sizeof(*row_average));
+
+  for (x = 0; x < q->w; x++)
+  {
+    const int u = q->w - 1 - x;
+
+    avg_fwd = (((uint64_t)avg_fwd * decay) >> 32) + src[x];
+    avg_rev = (((uint64_t)avg_rev * decay) >> 32) + src[u];
+
+    row_average[x] += avg_fwd;
+    row_average[u] += avg_rev;
+  }
+
+  binarise_row(threshold_dst(q, y), src, row_average, q->w,
+               200 * ts->threshold_s);
+
+  /* Serpentine: each average carries on from where it stopped, in
+   * the opposite direction, on the next row.
+   */
+  ts->avg_fwd = avg_rev;
+  ts->avg_rev = avg_fwd;
+}
+
+/* Box filter threshold. A pixel is dark if it is THRESHOLD_T percent
+ * below the mean of the (2r+1) x (2r+1) window around it, with the
+ * image edges replicated outwards so that every window has the same
+ * area.
+ *
+ * Each column keeps the running sum of its window; advancing a row adds
+ * the pixel entering at the bottom and subtracts the one leaving at the
+ * top. Rows may be binarised in place, so the last r + 1 original rows
+ * are kept in a ring for the subtraction. The comparison against the
+ * mean uses a precomputed reciprocal of the window area.
+ */
+static void box_begin(struct quirc *q, struct threshold_state *ts, int y0)
+{
+  const int w = q->w;
+  const int h = q->h;
+  const int r = quirc_threshold_radius(q->image_w);
+  const int d = 2 * r + 1;
+  uint32_t *col = q->threshold_sums;
+  int x, k;
+
+  ts->r = r;
+  ts->recip = ((uint32_t)(100 - THRESHOLD_T) << 24) / (100u * d * d);
+
+  memset(col, 0, w * sizeof(*col));
+
+  for (k = y0 - r; k <= y0 + r; k++)
+  {
+    const int y = k < 0 ? 0 : (k < h ? k : h - 1);
+    const uint8_t *src = q->source + y * q->source_stride;
+
+    for (x = 0; x < w; x++)
+      col[x] += src[x];
+  }
+
+  /* A band starting further down has not seen the rows above it, whose
+   * originals the window subtracts again. They are read straight from
+   * the source, which is never binarised in place when bands are used.
+   */
+  for (k = y0 > r ? y0 - r : 0; k < y0; k++)
+    memcpy(q->threshold_rows + (k % (r + 1)) * w,
+           q->source + k * q->source_stride, w);
+}
+
+static void box_row(struct quirc *q, struct threshold_state *ts, int y)
+{
+  const int w = q->w;
+  const int h = q->h;
+  const int r = ts->r;
+  const uint32_t recip = ts->recip;
+  uint32_t *col = q->threshold_sums;
+  const uint8_t *src = q->source + y * q->source_stride;
+  quirc_pixel_t *dst = threshold_dst(q, y);
+  uint8_t *saved = q->threshold_rows + (y % (r + 1)) * w;
+  uint32_t sum = (r + 1) * col[0];
+  int x, k;
+
+  for (k = 1; k <= r; k++)
+    sum += col[k < w ? k : w - 1];
+
+  for (x = 0; x < w; x++)
+  {
+    const int in = x + r + 1;
+    const int out = x - r;
+
+    saved[x] = src[x];
+    dst[x] = (saved[x] < ((sum * recip) >> 24)) ? QUIRC_PIXEL_BLACK
+                                                : QUIRC_PIXEL_WHITE;
+
+    sum += col[in < w ? in : w - 1];
+    sum -= col[out > 0 ? out : 0];
+  }
+
+  if (y + 1 < h)
+  {
+    const int in = y + r + 1;
+    const int out = y - r;
+    const uint8_t *add =
+        q->source + (in < h ? in : h - 1) * q->source_stride;
+    const uint8_t *sub =
+        q->threshold_rows + ((out > 0 ? out : 0) % (r + 1)) * w;
+
+    for (x = 0; x < w; x++)
+      col[x] += add[x] - sub[x];
+  }
+}
+
+/* Prepare to threshold rows from y0 on. */
+static void threshold_begin(struct quirc *q, struct threshold_state *ts,
+                            int y0)
+{
+  if (q->threshold_method == QUIRC_THRESHOLD_BOX)
+    box_begin(q, ts, y0);
+  else
+    serpentine_begin(q, ts, y0);
+}
+
+static void threshold_row(struct quirc *q, struct threshold_state *ts, int y)
+{
+  if (q->threshold_method == QUIRC_THRESHOLD_BOX)
+    box_row(q, ts, y);
+  else
+    serpentine_row(q, ts, y);
+
+  if (q->use_bits)
+    bits_pack_row(q, y);
+}
+
+/************************************************************************
+ * Run-length encoded rows
+ *
+ * Each row is cut into runs of dark pixels straight after it has been
+ * binarised, while it is still in cache. The finder scan and the
+ * run-based labeller then work from the runs and never look at the
+ * pixels of the row again. Region labels written into q->pixels later
+ * on do not change which pixels are dark, so the runs stay valid.
+ */
+
+/* Copy the first used elements of array into a new one of twice the
+ * size (or min_size, if larger). Returns NULL if out of memory, in which
+ * case the old array is left alone.
+ */
+static void *grow_array(void *array, int used, int *size, size_t elem,
+                        int min_size)
+{
+  int new_size = *size * 2;
+  void *new_array;
+
+  if (new_size < min_size)
+    new_size = min_size;
+
+  new_array = ps_malloc((size_t)new_size * elem);
+  if (!new_array)
+    return NULL;
+
+  if (array)
+  {
+    memcpy(new_array, array, (size_t)used * elem);
+    free(array);
+  }
+
+  *size = new_size;
+  return new_array;
+}
+
+static int rle_begin(struct quirc *q)
+{
+  if (!q->row_runs)
+  {
+    q->row_runs = ps_malloc((q->image_h + 1) * sizeof(*q->row_runs));
+    if (!q->row_runs)
+      return -1;
+  }
+
+  q->num_runs = 0;
+  return 0;
+}
+
+/* Return the first x from start up to w at which the row is not value.
+ * Byte-sized pixels are compared four at a time.
+ */
+static int run_end(const quirc_pixel_t *row, int x, int w, int value)
+{
+#if QUIRC_MAX_REGIONS < UINT8_MAX && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  const uint32_t pattern = value * 0x01010101u;
+
+  for (; x + 4 <= w; x += 4)
+  {
+    uint32_t v;
+
+    memcpy(&v, row + x, sizeof(v));
+    v ^= pattern;
+    if (v)
+      return x + (__builtin_ctz(v) >> 3);
+  }
+#endif
+
+  while (x < w && row[x] == value)
+    x++;
+
+  return x;
+}
+
+/* Append the runs of row y, which must follow row y - 1. Returns -1 if
+ * the run array could not be grown.
+ */
+static int rle_row(struct quirc *q, int y)
+{
+  const quirc_pixel_t *row = q->pixels + y * q->w;
+  const uint32_t *bits = q->bits + y * q->bit_stride;
+  int x = 0;
+
+  q->row_runs[y] = q->num_runs;
+
+  for (;;)
+  {
+    struct quirc_run *run;
+    int left;
+
+    x = q->use_bits ? bit_run_end(bits, x, q->w, QUIRC_PIXEL_WHITE)
+                    : run_end(row, x, q->w, QUIRC_PIXEL_WHITE);
+    if (x >= q->w)
+      break;
+
+    left = x;
+    x = q->use_bits ? bit_run_end(bits, x, q->w, QUIRC_PIXEL_BLACK)
+                    : run_end(row, x, q->w, QUIRC_PIXEL_BLACK);
+
+    if (q->num_runs >= q->max_runs)
+    {
+      struct quirc_run *runs = grow_array(q->runs, q->num_runs,
+                                          &q->max_runs, sizeof(*runs),
+                                          q->w * 4);
+
+      if (!runs)
+        return -1;
+      q->runs = runs;
+    }
+
+    run = &q->runs[q->num_runs];
+    run->y = y;
+    run->left = left;
+    run->right = x - 1;
+    run->label = q->num_runs;
+    q->num_runs++;
+  }
+
+  q->row_runs[y + 1] = q->num_runs;
+  return 0;
+}
+
+/* Binarise row y and, unless it has been given up for this image, add
+ * its runs.
+ */
+static void threshold_rle_row(struct quirc *q, struct threshold_state *ts,
+                              int y)
+{
+  threshold_row(q, ts, y);
+
+  if (q->rle && rle_row(q, y) < 0)
+    q->rle = 0;
+}
+
+static void threshold(struct quirc *q)
+{
+  struct threshold_state ts;
+  int y;
+
+  threshold_begin(q, &ts, 0);
+
   for (y = 0; y < q->h; y++)
+    threshold_rle_row(q, &ts, y);
+}
+
+static void area_count(void *user_data, int y, int left, int right)
+{
+  ((struct quirc_region *)user_data)->count += right - left + 1;
+}
+
+/************************************************************************
+ * Run-based region labelling
+ *
+ * The alternative to flood filling regions as they are needed. Each run
+ * is joined with union-find to the runs on the row above which share a
+ * column with it. A final pass over the runs numbers the regions and
+ * totals their areas. The labels stay with the runs instead of being
+ * written into q->pixels, so their number is not limited by
+ * quirc_pixel_t.
+ */
+
+static int label_find(struct quirc_run *runs, int i)
+{
+  while (runs[i].label != i)
+  {
+    runs[i].label = runs[runs[i].label].label;
+    i = runs[i].label;
+  }
+
+  return i;
+}
+
+/* Join the runs of row y to those of row y - 1. */
+static void label_row(struct quirc *q, int y)
+{
+  const int first = q->row_runs[y];
+  const int end = q->row_runs[y + 1];
+  int above = y ? q->row_runs[y - 1] : first;
+  int i;
+
+  for (i = first; i < end; i++)
   {
-    int row_average[q->w];
+    const struct quirc_run *run = &q->runs[i];
+    int k;
 
-    memset(row_average, 0, sizeof(row_average));
+    /* Runs are in column order, so skip those above which end to the
+     * left of this one and join the rest until one starts to its right.
+     */
+    while (above < first && q->runs[above].right < run->left)
+      above++;
 
-    for (x = 0; x < q->w; x++)
+    for (k = above; k < first && q->runs[k].left <= run->right; k++)
     {
-      int w, u;
+      int a = label_find(q->runs, k);
+      int b = label_find(q->runs, i);
+
+      /* The lower index becomes the root, so every run's label points
+       * backwards and the root is the first run of its region.
+       */
+      if (a < b)
+        q->runs[b].label = a;
+      else if (b < a)
+        q->runs[a].label = b;
+    }
+  }
+}
 
-      if (y & 1)
-      {
-        w = x;
-        u = q->w - 1 - x;
-      }
-      else
+/* Number the regions once every row has been added. */
+static int label_finish(struct quirc *q)
+{
+  int n = QUIRC_PIXEL_REGION;
+  int i;
+
+  for (i = 0; i < q->num_runs; i++)
+  {
+    struct quirc_run *run = &q->runs[i];
+    struct quirc_region *reg;
+
+    if (run->label == i)
+    {
+      if (n >= q->max_run_regions)
       {
-        w = q->w - 1 - x;
-        u = x;
-      }
+        struct quirc_region *regions =
+            grow_array(q->run_regions, n, &q->max_run_regions,
+                       sizeof(*regions), QUIRC_MAX_REGIONS);
 
-      avg_w = (avg_w * (threshold_s - 1)) /
-                  threshold_s +
-              row[w];
-      avg_u = (avg_u * (threshold_s - 1)) /
-                  threshold_s +
-              row[u];
+        if (!regions)
+          return -1;
+        q->run_regions = regions;
+      }
 
-      row_average[w] += avg_w;
-      row_average[u] += avg_u;
+      reg = &q->run_regions[n];
+      reg->seed.x = run->left;
+      reg->seed.y = run->y;
+      reg->count = 0;
+      reg->capstone = -1;
+      reg->run_first = i;
+      run->label = n++;
     }
-
-    for (x = 0; x < q->w; x++)
+    else
     {
-      if (row[x] < row_average[x] *
-                       (100 - THRESHOLD_T) / (200 * threshold_s))
-        row[x] = QUIRC_PIXEL_BLACK;
-      else
-        row[x] = QUIRC_PIXEL_WHITE;
+      /* The run it points to comes first and is already numbered */
+      run->label = q->runs[run->label].label;
     }
 
-    row += q->w;
+    reg = &q->run_regions[run->label];
+    reg->count += run->right - run->left + 1;
+    reg->run_last = i;
   }
+
+  q->num_regions = n;
+  return 0;
 }
 
-static void area_count(void *user_data, int y, int left, int right)
+/* Label the regions of an image whose runs are all in place, then make
+ * them current. Rows before from have already been joined. Without
+ * runs, or if the region table cannot be grown, the image is left to
+ * flood fill.
+ */
+static void label_regions(struct quirc *q, int from)
 {
-  ((struct quirc_region *)user_data)->count += right - left + 1;
+  int y;
+
+  if (!q->rle)
+    q->label_runs = 0;
+
+  if (q->label_runs)
+  {
+    for (y = from; y < q->h; y++)
+      label_row(q, y);
+
+    if (label_finish(q) < 0)
+      q->label_runs = 0;
+  }
+
+  q->regions = q->label_runs ? q->run_regions : q->region_table;
+}
+
+/* Find the region containing a dark pixel from the runs of its row. */
+static int run_region_code(struct quirc *q, int x, int y)
+{
+  int lo = q->row_runs[y];
+  int hi = q->row_runs[y + 1] - 1;
+
+  while (lo < hi)
+  {
+    const int mid = (lo + hi + 1) / 2;
+
+    if (q->runs[mid].left <= x)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  return q->runs[lo].label;
+}
+
+/* Pass each run of a region to func, in row order. */
+static void region_runs(struct quirc *q, int rcode,
+                        span_func_t func, void *user_data)
+{
+  const struct quirc_region *reg = &q->regions[rcode];
+  int i;
+
+  for (i = reg->run_first; i <= reg->run_last; i++)
+  {
+    const struct quirc_run *run = &q->runs[i];
+
+    if (run->label == rcode)
+      func(user_data, run->y, run->left, run->right);
+  }
 }
 
 static int region_code(struct quirc *q, int x, int y)
@@ -323,7 +1288,15 @@ static int region_code(struct quirc *q, int x, int y)
   if (x < 0 || y < 0 || x >= q->w || y >= q->h)
     return -1;
 
+  if (q->label_runs)
+    return pixel_dark(q, x, y) ? run_region_code(q, x, y) : -1;
+
+  /* Only the runs carry labels for the bit plane */
+  if (q->use_bits)
+    return -1;
+
   pixel = q->pixels[y * q->w + x];
+
   //预先判断非正常的像素情况，退出
   if (pixel >= QUIRC_PIXEL_REGION)
     return pixel;
@@ -417,9 +1390,12 @@ static void find_region_corners(struct quirc *q,
 
   memcpy(&psd.ref, ref, sizeof(psd.ref));
   psd.scores[0] = -1;
-  flood_fill_seed(q, region->seed.x, region->seed.y,
-                  rcode, QUIRC_PIXEL_BLACK,
-                  find_one_corner, &psd, 0);
+  if (q->label_runs)
+    region_runs(q, rcode, find_one_corner, &psd);
+  else
+    flood_fill_seed(q, region->seed.x, region->seed.y,
+                    rcode, QUIRC_PIXEL_BLACK,
+                    find_one_corner, &psd, 0);
 
   psd.ref.x = psd.corners[0].x - psd.ref.x;
   psd.ref.y = psd.corners[0].y - psd.ref.y;
@@ -435,9 +1411,12 @@ static void find_region_corners(struct quirc *q,
   psd.scores[1] = i;
   psd.scores[3] = -i;
 
-  flood_fill_seed(q, region->seed.x, region->seed.y,
-                  QUIRC_PIXEL_BLACK, rcode,
-                  find_other_corners, &psd, 0);
+  if (q->label_runs)
+    region_runs(q, rcode, find_other_corners, &psd);
+  else
+    flood_fill_seed(q, region->seed.x, region->seed.y,
+                    QUIRC_PIXEL_BLACK, rcode,
+                    find_other_corners, &psd, 0);
 }
 
 static void record_capstone(struct quirc *q, int ring, int stone)
@@ -465,8 +1444,9 @@ static void record_capstone(struct quirc *q, int ring, int stone)
   find_region_corners(q, ring, &stone_reg->seed, capstone->corners);
 
   /* Set up the perspective transform and find the center */
-  perspective_setup(capstone->c, capstone->corners, 7.0, 7.0);
-  perspective_map(capstone->c, 3.5, 3.5, &capstone->center);
+  perspective_setup(capstone->c, capstone->corners, 7, 7);
+  perspective_map(capstone->c, QUIRC_FIX(3.5), QUIRC_FIX(3.5),
+                  &capstone->center);
 }
 
 static void test_capstone(struct quirc *q, int x, int y, int *pb)
@@ -504,7 +1484,91 @@ static void test_capstone(struct quirc *q, int x, int y, int *pb)
   record_capstone(q, ring_left, stone);
 }
 
-static void finder_scan(struct quirc *q, int y)
+/* Remember a finder pattern candidate found by finder_scan() so that it
+ * can be tested once the whole image has been thresholded. Returns -1
+ * if there is no room left.
+ */
+static int defer_capstone(struct quirc *q, int x, int y, const int *pb)
+{
+  struct quirc_finder_hit *hit;
+  int i;
+
+  if (q->num_finder_hits >= QUIRC_MAX_FINDER_HITS)
+    return -1;
+
+  hit = &q->finder_hits[q->num_finder_hits++];
+  hit->x = x;
+  hit->y = y;
+  for (i = 0; i < 5; i++)
+    hit->pb[i] = pb[i];
+
+  return 0;
+}
+
+/* Check the last five run lengths for the 1:1:3:1:1 finder pattern
+ * ratio, x being the first light pixel after them. Candidates are passed
+ * straight to test_capstone(), or, if defer is set, queued with
+ * defer_capstone(); the latter returns -1 if the queue overflows.
+ */
+static int finder_check(struct quirc *q, int x, int y, int *pb, int defer)
+{
+  static const int check[5] = {1, 1, 3, 1, 1};
+  int avg, err;
+  int i;
+
+  avg = (pb[0] + pb[1] + pb[3] + pb[4]) / 4;
+  err = avg * 3 / 4;
+
+  for (i = 0; i < 5; i++)
+    if (pb[i] < check[i] * avg - err ||
+        pb[i] > check[i] * avg + err)
+      return 0;
+
+  if (!defer)
+    test_capstone(q, x, y, pb);
+  else if (defer_capstone(q, x, y, pb) < 0)
+    return -1;
+
+  return 0;
+}
+
+/* Finder scan over the runs of a row: every dark run with two more
+ * before it closes a dark-light-dark-light-dark sequence, so the run
+ * lengths come straight from the run bounds. A run reaching the right
+ * edge has no light pixel after it and is not checked, as in the pixel
+ * scan below.
+ */
+static int finder_scan_runs(struct quirc *q, int y, int defer)
+{
+  const struct quirc_run *runs = q->runs;
+  const int end = q->row_runs[y + 1];
+  int k;
+
+  for (k = q->row_runs[y] + 2; k < end; k++)
+  {
+    int pb[5];
+
+    if (runs[k].right >= q->w - 1)
+      break;
+
+    pb[0] = runs[k - 2].right - runs[k - 2].left + 1;
+    pb[1] = runs[k - 1].left - runs[k - 2].right - 1;
+    pb[2] = runs[k - 1].right - runs[k - 1].left + 1;
+    pb[3] = runs[k].left - runs[k - 1].right - 1;
+    pb[4] = runs[k].right - runs[k].left + 1;
+
+    if (finder_check(q, runs[k].right + 1, y, pb, defer) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+/* Scan a row for the 1:1:3:1:1 finder pattern ratio, from its runs if
+ * the image has them, otherwise pixel by pixel. Returns -1 if a deferred
+ * candidate could not be queued.
+ */
+static int finder_scan(struct quirc *q, int y, int defer)
 {
   quirc_pixel_t *row = q->pixels + y * q->w;
   int x;
@@ -513,6 +1577,15 @@ static void finder_scan(struct quirc *q, int y)
   int run_count = 0;
   int pb[5]; //means QRcode's pixel width
 
+  if (q->rle)
+    return finder_scan_runs(q, y, defer);
+
+  /* Without runs the bit plane cannot be labelled, so there is no use
+   * looking for candidates.
+   */
+  if (q->use_bits)
+    return 0;
+
   memset(pb, 0, sizeof(pb));
   for (x = 0; x < q->w; x++)
   {
@@ -525,29 +1598,17 @@ static void finder_scan(struct quirc *q, int y)
       run_length = 0;
       run_count++; //get more than 5 time color jump
 
-      if (!color && run_count >= 5)
-      { // find the marker of QRcode(three corner's marker)
-        static int check[5] = {1, 1, 3, 1, 1};
-        int avg, err;
-        int i;
-        int ok = 1;
-
-        avg = (pb[0] + pb[1] + pb[3] + pb[4]) / 4;
-        err = avg * 3 / 4;
-
-        for (i = 0; i < 5; i++)
-          if (pb[i] < check[i] * avg - err ||
-              pb[i] > check[i] * avg + err)
-            ok = 0;
-
-        if (ok)
-          test_capstone(q, x, y, pb);
-      }
+      // find the marker of QRcode(three corner's marker)
+      if (!color && run_count >= 5 &&
+          finder_check(q, x, y, pb, defer) < 0)
+        return -1;
     }
 
     run_length++;
     last_color = color;
   }
+
+  return 0;
 }
 
 static void find_alignment_pattern(struct quirc *q, int index)
@@ -561,7 +1622,7 @@ static void find_alignment_pattern(struct quirc *q, int index)
   int size_estimate;
   int step_size = 1;
   int dir = 0;
-  float u, v;
+  quirc_coord_t u, v;
 
   /* Grab our previous estimate of the alignment pattern corner */
   memcpy(&b, &qr->align, sizeof(b));
@@ -570,9 +1631,9 @@ static void find_alignment_pattern(struct quirc *q, int index)
      * can estimate its size.
      */
   perspective_unmap(c0->c, &b, &u, &v);
-  perspective_map(c0->c, u, v + 1.0, &a);
+  perspective_map(c0->c, u, v + QUIRC_FIX(1.0), &a);
   perspective_unmap(c2->c, &b, &u, &v);
-  perspective_map(c2->c, u + 1.0, v, &c);
+  perspective_map(c2->c, u + QUIRC_FIX(1.0), v, &c);
 
   size_estimate = abs((a.x - b.x) * -(c.y - b.y) +
                       (a.y - b.y) * (c.x - b.x));
@@ -697,14 +1758,10 @@ static int timing_scan(const struct quirc *q,
   y = p0->y;
   for (i = 0; i <= d; i++)
   {
-    int pixel;
-
     if (y < 0 || y >= q->h || x < 0 || x >= q->w)
       break;
 
-    pixel = q->pixels[y * q->w + x];
-
-    if (pixel)
+    if (pixel_dark(q, x, y))
     {
       if (run_length >= 2)
         count++;
@@ -746,8 +1803,10 @@ static int measure_timing_pattern(struct quirc *q, int index)
 
   for (i = 0; i < 3; i++)
   {
-    static const float us[] = {6.5, 6.5, 0.5};
-    static const float vs[] = {0.5, 6.5, 6.5};
+    static const quirc_coord_t us[] = {QUIRC_FIX(6.5), QUIRC_FIX(6.5),
+                                       QUIRC_FIX(0.5)};
+    static const quirc_coord_t vs[] = {QUIRC_FIX(0.5), QUIRC_FIX(6.5),
+                                       QUIRC_FIX(6.5)};
     struct quirc_capstone *cap = &q->capstones[qr->caps[i]];
 
     perspective_map(cap->c, us[i], vs[i], &qr->tpep[i]);
@@ -772,170 +1831,527 @@ static int measure_timing_pattern(struct quirc *q, int index)
   return 0;
 }
 
-/* Read a cell from a grid using the currently set perspective
- * transform. Returns +/- 1 for black/white, 0 for cells which are
- * out of image bounds.
+/* Read a cell from a grid, given the point its centre maps to. Returns
+ * +/- 1 for black/white, 0 for cells which are out of image bounds.
  */
-static int read_cell(const struct quirc *q, int index, int x, int y)
+static int read_cell(const struct quirc *q, const struct quirc_point *p)
 {
-  const struct quirc_grid *qr = &q->grids[index];
-  struct quirc_point p;
-
-  perspective_map(qr->c, x + 0.5, y + 0.5, &p);
-  if (p.y < 0 || p.y >= q->h || p.x < 0 || p.x >= q->w)
+  if (p->y < 0 || p->y >= q->h || p->x < 0 || p->x >= q->w)
     return 0;
 
-  return q->pixels[p.y * q->w + p.x] ? 1 : -1;
+  return pixel_dark(q, p->x, p->y) ? 1 : -1;
 }
 
-static int fitness_cell(const struct quirc *q, int index, int x, int y)
+/* Score a cell by nine samples spread over it, or when coarse by the
+ * one at its centre.
+ */
+static int fitness_cell(const struct quirc *q, int index, int x, int y,
+                        int coarse)
 {
   const struct quirc_grid *qr = &q->grids[index];
   int score = 0;
   int u, v;
 
+  if (coarse)
+  {
+    struct quirc_point p;
+
+    perspective_map(qr->c, QUIRC_INT(x) + QUIRC_FIX(0.5f),
+                    QUIRC_INT(y) + QUIRC_FIX(0.5f), &p);
+    return read_cell(q, &p);
+  }
+
   for (v = 0; v < 3; v++)
     for (u = 0; u < 3; u++)
     {
-      static const float offsets[] = {0.3, 0.5, 0.7};
+      static const quirc_coord_t offsets[] = {
+          QUIRC_FIX(0.3), QUIRC_FIX(0.5), QUIRC_FIX(0.7)};
       struct quirc_point p;
 
-      perspective_map(qr->c, x + offsets[u],
-                      y + offsets[v], &p);
-      if (p.y < 0 || p.y >= q->h || p.x < 0 || p.x >= q->w)
-        continue;
+      perspective_map(qr->c, QUIRC_INT(x) + offsets[u],
+                      QUIRC_INT(y) + offsets[v], &p);
+      score += read_cell(q, &p);
+    }
+
+  return score;
+}
+
+static int fitness_ring(const struct quirc *q, int index, int cx, int cy,
+                        int radius, int coarse)
+{
+  int i;
+  int score = 0;
+
+  for (i = 0; i < radius * 2; i++)
+  {
+    score += fitness_cell(q, index, cx - radius + i, cy - radius, coarse);
+    score += fitness_cell(q, index, cx - radius, cy + radius - i, coarse);
+    score += fitness_cell(q, index, cx + radius, cy - radius + i, coarse);
+    score += fitness_cell(q, index, cx + radius - i, cy + radius, coarse);
+  }
+
+  return score;
+}
+
+static int fitness_apat(const struct quirc *q, int index, int cx, int cy,
+                        int coarse)
+{
+  return fitness_cell(q, index, cx, cy, coarse) -
+         fitness_ring(q, index, cx, cy, 1, coarse) +
+         fitness_ring(q, index, cx, cy, 2, coarse);
+}
+
+static int fitness_capstone(const struct quirc *q, int index, int x, int y,
+                            int coarse)
+{
+  x += 3;
+  y += 3;
+
+  return fitness_cell(q, index, x, y, coarse) +
+         fitness_ring(q, index, x, y, 1, coarse) -
+         fitness_ring(q, index, x, y, 2, coarse) +
+         fitness_ring(q, index, x, y, 3, coarse);
+}
+
+/* Compute a fitness score for the currently configured perspective
+ * transform, using the features we expect to find by scanning the
+ * grid.
+ */
+static int fitness_all(const struct quirc *q, int index, int coarse)
+{
+  const struct quirc_grid *qr = &q->grids[index];
+  int version = (qr->grid_size - 17) / 4;
+  const struct quirc_version_info *info = &quirc_version_db[version];
+  int score = 0;
+  int i, j;
+  int ap_count;
+
+  /* Check the timing pattern */
+  for (i = 0; i < qr->grid_size - 14; i++)
+  {
+    int expect = (i & 1) ? 1 : -1;
+
+    score += fitness_cell(q, index, i + 7, 6, coarse) * expect;
+    score += fitness_cell(q, index, 6, i + 7, coarse) * expect;
+  }
+
+  /* Check capstones */
+  score += fitness_capstone(q, index, 0, 0, coarse);
+  score += fitness_capstone(q, index, qr->grid_size - 7, 0, coarse);
+  score += fitness_capstone(q, index, 0, qr->grid_size - 7, coarse);
+
+  if (version < 0 || version > QUIRC_MAX_VERSION)
+    return score;
+
+  /* Check alignment patterns */
+  ap_count = 0;
+  while ((ap_count < QUIRC_MAX_ALIGNMENT) && info->apat[ap_count])
+    ap_count++;
+
+  for (i = 1; i + 1 < ap_count; i++)
+  {
+    score += fitness_apat(q, index, 6, info->apat[i], coarse);
+    score += fitness_apat(q, index, info->apat[i], 6, coarse);
+  }
+
+  for (i = 1; i < ap_count; i++)
+    for (j = 1; j < ap_count; j++)
+      score += fitness_apat(q, index,
+                            info->apat[i], info->apat[j], coarse);
+  //mp_printf(&mp_plat_print, "##score=%d\n",score);
+  return score;
+}
+
+/* Hill climb on the fitness score: try moving each parameter by a step
+ * in both directions, first a fraction of its value, and halve the
+ * steps after each pass.
+ */
+static void jiggle_perspective(struct quirc *q, int index, int passes,
+                               quirc_coord_t fraction, int coarse)
+{
+  struct quirc_grid *qr = &q->grids[index];
+  int best = fitness_all(q, index, coarse);
+  int pass;
+  quirc_coord_t adjustments[8];
+  int i;
+
+  for (i = 0; i < 8; i++)
+    adjustments[i] = QUIRC_MUL(qr->c[i], fraction);
+
+  for (pass = 0; pass < passes; pass++)
+  {
+    for (i = 0; i < 16; i++)
+    {
+      int j = i >> 1;
+      int test;
+      quirc_coord_t old = qr->c[j];
+      quirc_coord_t step = adjustments[j];
+      quirc_coord_t new;
 
-      if (q->pixels[p.y * q->w + p.x])
-        score++;
+      if (i & 1)
+        new = old + step;
+      else
+        new = old - step;
+
+      qr->c[j] = new;
+      test = fitness_all(q, index, coarse);
+
+      if (test > best)
+        best = test;
       else
-        score--;
+        qr->c[j] = old;
     }
 
-  return score;
+    for (i = 0; i < 8; i++)
+      adjustments[i] /= 2;
+  }
+}
+
+/* Least-squares refinement
+ *
+ * Instead of searching for the transform, fit it to points whose place
+ * in both the grid and the image is known: the outer corners of the
+ * three capstones, the corner of the alignment pattern, and every edge
+ * between two modules of the two timing patterns. Corners are the
+ * outermost dark pixels of their regions, so they are moved half a
+ * pixel outwards first.
+ */
+/* Timing pattern edges on a grid of the largest version, and points */
+#define FIT_MAX_EDGES (QUIRC_MAX_VERSION * 4 + 4)
+#define FIT_MAX_POINTS (FIT_MAX_EDGES * 2 + 13)
+
+struct fit_point
+{
+  float u, v;
+  float x, y;
+};
+
+struct fit_data
+{
+  int count;
+  struct fit_point points[FIT_MAX_POINTS];
+};
+
+static void fit_add(struct fit_data *fd, float u, float v, float x, float y)
+{
+  struct fit_point *p;
+
+  if (fd->count >= FIT_MAX_POINTS)
+    return;
+
+  p = &fd->points[fd->count++];
+  p->u = u;
+  p->v = v;
+  p->x = x;
+  p->y = y;
+}
+
+/* Add a region corner, moved half a pixel away from a point inside. */
+static void fit_add_corner(struct fit_data *fd, float u, float v,
+                           const struct quirc_point *corner,
+                           const struct quirc_point *inside)
+{
+  float x = corner->x;
+  float y = corner->y;
+
+  if (corner->x < inside->x)
+    x -= 0.5f;
+  else if (corner->x > inside->x)
+    x += 0.5f;
+
+  if (corner->y < inside->y)
+    y -= 0.5f;
+  else if (corner->y > inside->y)
+    y += 0.5f;
+
+  fit_add(fd, u, v, x, y);
+}
+
+/* Do a Bresenham scan along a timing pattern, from the dark module at
+ * grid cell 6 to the one at grid_size - 7, and add the point halfway
+ * between the pixels either side of each colour change. Edges are kept
+ * as the sum of those two pixels until then. The pattern is
+ * only used if it has exactly the grid_size - 13 edges expected, the
+ * first of which is at 7 along the pattern.
+ */
+static void fit_timing(const struct quirc *q, struct fit_data *fd,
+                       const struct quirc_point *p0,
+                       const struct quirc_point *p1,
+                       int grid_size, int vertical)
+{
+  struct quirc_point edges[FIT_MAX_EDGES];
+  int expect = grid_size - 13;
+  int n = p1->x - p0->x;
+  int d = p1->y - p0->y;
+  int x = p0->x;
+  int y = p0->y;
+  int *dom, *nondom;
+  int dom_step;
+  int nondom_step;
+  int a = 0;
+  int i;
+  int count = 0;
+  int dark = 1;
+  int px = x;
+  int py = y;
+
+  if (p0->x < 0 || p0->y < 0 || p0->x >= q->w || p0->y >= q->h)
+    return;
+  if (p1->x < 0 || p1->y < 0 || p1->x >= q->w || p1->y >= q->h)
+    return;
+
+  if (abs(n) > abs(d))
+  {
+    int swap = n;
+
+    n = d;
+    d = swap;
+
+    dom = &x;
+    nondom = &y;
+  }
+  else
+  {
+    dom = &y;
+    nondom = &x;
+  }
+
+  if (n < 0)
+  {
+    n = -n;
+    nondom_step = -1;
+  }
+  else
+  {
+    nondom_step = 1;
+  }
+
+  if (d < 0)
+  {
+    d = -d;
+    dom_step = -1;
+  }
+  else
+  {
+    dom_step = 1;
+  }
+
+  for (i = 0; i <= d; i++)
+  {
+    if (pixel_dark(q, x, y) != dark)
+    {
+      if (!i || count >= expect || count >= FIT_MAX_EDGES)
+        return;
+
+      edges[count].x = px + x;
+      edges[count].y = py + y;
+      count++;
+      dark = !dark;
+    }
+
+    px = x;
+    py = y;
+
+    a += n;
+    *dom += dom_step;
+    if (a >= d)
+    {
+      *nondom += nondom_step;
+      a -= d;
+    }
+  }
+
+  if (count != expect)
+    return;
+
+  for (i = 0; i < count; i++)
+  {
+    float along = i + 7;
+
+    if (vertical)
+      fit_add(fd, 6.5f, along, edges[i].x * 0.5f, edges[i].y * 0.5f);
+    else
+      fit_add(fd, along, 6.5f, edges[i].x * 0.5f, edges[i].y * 0.5f);
+  }
 }
 
-static int fitness_ring(const struct quirc *q, int index, int cx, int cy,
-                        int radius)
+/* Solve for the transform which best maps the grid points to the image
+ * points, in the least-squares sense of the linearised equations
+ *
+ *     c0 u + c1 v + c2 - c6 u x - c7 v x = x
+ *     c3 u + c4 v + c5 - c6 u y - c7 v y = y
+ *
+ * Both sets of points are first centred and scaled to an average
+ * distance of about 1 from the origin, which keeps the normal equations
+ * well enough conditioned to be solved in single precision. Returns -1
+ * if they are singular.
+ */
+static int fit_solve(quirc_coord_t *c, const struct fit_data *fd)
 {
-  int i;
-  int score = 0;
+  float ata[8][9];
+  float mu = 0, mv = 0, mx = 0, my = 0;
+  float su = 0, sx = 0;
+  float m[3][3];
+  int i, j, k;
 
-  for (i = 0; i < radius * 2; i++)
+  if (fd->count < 4)
+    return -1;
+
+  for (i = 0; i < fd->count; i++)
   {
-    score += fitness_cell(q, index, cx - radius + i, cy - radius);
-    score += fitness_cell(q, index, cx - radius, cy + radius - i);
-    score += fitness_cell(q, index, cx + radius, cy - radius + i);
-    score += fitness_cell(q, index, cx + radius - i, cy + radius);
+    mu += fd->points[i].u;
+    mv += fd->points[i].v;
+    mx += fd->points[i].x;
+    my += fd->points[i].y;
   }
+  mu /= fd->count;
+  mv /= fd->count;
+  mx /= fd->count;
+  my /= fd->count;
 
-  return score;
-}
+  for (i = 0; i < fd->count; i++)
+  {
+    su += fabsf(fd->points[i].u - mu) + fabsf(fd->points[i].v - mv);
+    sx += fabsf(fd->points[i].x - mx) + fabsf(fd->points[i].y - my);
+  }
+  if (su <= 0 || sx <= 0)
+    return -1;
+  su = fd->count / su;
+  sx = fd->count / sx;
 
-static int fitness_apat(const struct quirc *q, int index, int cx, int cy)
-{
-  return fitness_cell(q, index, cx, cy) -
-         fitness_ring(q, index, cx, cy, 1) +
-         fitness_ring(q, index, cx, cy, 2);
-}
+  memset(ata, 0, sizeof(ata));
+  for (i = 0; i < fd->count; i++)
+  {
+    const struct fit_point *p = &fd->points[i];
+    float u = (p->u - mu) * su;
+    float v = (p->v - mv) * su;
+    float x = (p->x - mx) * sx;
+    float y = (p->y - my) * sx;
+    float rx[9] = {u, v, 1, 0, 0, 0, -u * x, -v * x, x};
+    float ry[9] = {0, 0, 0, u, v, 1, -u * y, -v * y, y};
+
+    for (j = 0; j < 8; j++)
+      for (k = j; k < 9; k++)
+        ata[j][k] += rx[j] * rx[k] + ry[j] * ry[k];
+  }
 
-static int fitness_capstone(const struct quirc *q, int index, int x, int y)
-{
-  x += 3;
-  y += 3;
+  for (j = 1; j < 8; j++)
+    for (k = 0; k < j; k++)
+      ata[j][k] = ata[k][j];
 
-  return fitness_cell(q, index, x, y) +
-         fitness_ring(q, index, x, y, 1) -
-         fitness_ring(q, index, x, y, 2) +
-         fitness_ring(q, index, x, y, 3);
-}
+  /* Gauss-Jordan elimination with partial pivoting */
+  for (j = 0; j < 8; j++)
+  {
+    int pivot = j;
+    float scale;
 
-/* Compute a fitness score for the currently configured perspective
- * transform, using the features we expect to find by scanning the
- * grid.
- */
-static int fitness_all(const struct quirc *q, int index)
-{
-  const struct quirc_grid *qr = &q->grids[index];
-  int version = (qr->grid_size - 17) / 4;
-  const struct quirc_version_info *info = &quirc_version_db[version];
-  int score = 0;
-  int i, j;
-  int ap_count;
+    for (i = j + 1; i < 8; i++)
+      if (fabsf(ata[i][j]) > fabsf(ata[pivot][j]))
+        pivot = i;
 
-  /* Check the timing pattern */
-  for (i = 0; i < qr->grid_size - 14; i++)
-  {
-    int expect = (i & 1) ? 1 : -1;
+    if (fabsf(ata[pivot][j]) < 1e-6f)
+      return -1;
 
-    score += fitness_cell(q, index, i + 7, 6) * expect;
-    score += fitness_cell(q, index, 6, i + 7) * expect;
-  }
+    if (pivot != j)
+      for (k = 0; k < 9; k++)
+      {
+        float t = ata[j][k];
 
-  /* Check capstones */
-  score += fitness_capstone(q, index, 0, 0);
-  score += fitness_capstone(q, index, qr->grid_size - 7, 0);
-  score += fitness_capstone(q, index, 0, qr->grid_size - 7);
+        ata[j][k] = ata[pivot][k];
+        ata[pivot][k] = t;
+      }
 
-  if (version < 0 || version > QUIRC_MAX_VERSION)
-    return score;
+    scale = 1.0f / ata[j][j];
+    for (k = j; k < 9; k++)
+      ata[j][k] *= scale;
 
-  /* Check alignment patterns */
-  ap_count = 0;
-  while ((ap_count < QUIRC_MAX_ALIGNMENT) && info->apat[ap_count])
-    ap_count++;
+    for (i = 0; i < 8; i++)
+    {
+      float f = ata[i][j];
 
-  for (i = 1; i + 1 < ap_count; i++)
+      if (i == j || f == 0)
+        continue;
+
+      for (k = j; k < 9; k++)
+        ata[i][k] -= f * ata[j][k];
+    }
+  }
+
+  /* Undo the scaling: image = S^-1 H T grid, where T takes grid points
+   * to the fitted ones and S does the same for image points.
+   */
+  m[2][0] = ata[6][8] * su;
+  m[2][1] = ata[7][8] * su;
+  m[2][2] = 1.0f - ata[6][8] * su * mu - ata[7][8] * su * mv;
+
+  for (i = 0; i < 2; i++)
   {
-    score += fitness_apat(q, index, 6, info->apat[i]);
-    score += fitness_apat(q, index, info->apat[i], 6);
+    float mi = i ? my : mx;
+    float a0 = ata[i * 3][8];
+    float a1 = ata[i * 3 + 1][8];
+    float a2 = ata[i * 3 + 2][8];
+
+    m[i][0] = a0 * su / sx + mi * m[2][0];
+    m[i][1] = a1 * su / sx + mi * m[2][1];
+    m[i][2] = (a2 - a0 * su * mu - a1 * su * mv) / sx + mi * m[2][2];
   }
 
-  for (i = 1; i < ap_count; i++)
-    for (j = 1; j < ap_count; j++)
-      score += fitness_apat(q, index,
-                            info->apat[i], info->apat[j]);
-  //mp_printf(&mp_plat_print, "##score=%d\n",score);
-  return score;
+  if (fabsf(m[2][2]) < 1e-12f)
+    return -1;
+
+  c[0] = QUIRC_FIX(m[0][0] / m[2][2]);
+  c[1] = QUIRC_FIX(m[0][1] / m[2][2]);
+  c[2] = QUIRC_FIX(m[0][2] / m[2][2]);
+  c[3] = QUIRC_FIX(m[1][0] / m[2][2]);
+  c[4] = QUIRC_FIX(m[1][1] / m[2][2]);
+  c[5] = QUIRC_FIX(m[1][2] / m[2][2]);
+  c[6] = QUIRC_FIX_DEN(m[2][0] / m[2][2]);
+  c[7] = QUIRC_FIX_DEN(m[2][1] / m[2][2]);
+
+  return 0;
 }
 
-static void jiggle_perspective(struct quirc *q, int index)
+/* Fit the grid's transform to its features. Returns -1, leaving the
+ * transform alone, if there are too few of them to go on.
+ */
+static int fit_perspective(struct quirc *q, int index)
 {
+  static const float corner_u[] = {0, 7, 7, 0};
+  static const float corner_v[] = {0, 0, 7, 7};
   struct quirc_grid *qr = &q->grids[index];
-  int best = fitness_all(q, index);
-  int pass;
-  float adjustments[8];
+  struct fit_data fd;
+  float origin = qr->grid_size - 7;
   int i;
 
-  for (i = 0; i < 8; i++)
-    adjustments[i] = qr->c[i] * 0.02;
+  fd.count = 0;
 
-  for (pass = 0; pass < 5; pass++)
+  for (i = 0; i < 4; i++)
   {
-    for (i = 0; i < 16; i++)
-    {
-      int j = i >> 1;
-      int test;
-      float old = qr->c[j];
-      float step = adjustments[j];
-      float new;
+    const struct quirc_capstone *a = &q->capstones[qr->caps[0]];
+    const struct quirc_capstone *b = &q->capstones[qr->caps[1]];
+    const struct quirc_capstone *c = &q->capstones[qr->caps[2]];
+
+    fit_add_corner(&fd, corner_u[i], origin + corner_v[i],
+                   &a->corners[i], &a->center);
+    fit_add_corner(&fd, corner_u[i], corner_v[i],
+                   &b->corners[i], &b->center);
+    fit_add_corner(&fd, origin + corner_u[i], corner_v[i],
+                   &c->corners[i], &c->center);
+  }
 
-      if (i & 1)
-        new = old + step;
-      else
-        new = old - step;
+  if (qr->align_region >= 0)
+  {
+    struct quirc_point inside;
 
-      qr->c[j] = new;
-      test = fitness_all(q, index);
+    perspective_map(qr->c, QUIRC_INT(qr->grid_size - 7) + QUIRC_FIX(0.5f),
+                    QUIRC_INT(qr->grid_size - 7) + QUIRC_FIX(0.5f), &inside);
+    fit_add_corner(&fd, origin, origin, &qr->align, &inside);
+  }
 
-      if (test > best)
-        best = test;
-      else
-        qr->c[j] = old;
-    }
+  fit_timing(q, &fd, &qr->tpep[1], &qr->tpep[2], qr->grid_size, 0);
+  fit_timing(q, &fd, &qr->tpep[1], &qr->tpep[0], qr->grid_size, 1);
 
-    for (i = 0; i < 8; i++)
-      adjustments[i] *= 0.5;
-  }
+  return fit_solve(qr->c, &fd);
 }
 
 /* Once the capstones are in place and an alignment point has been
@@ -957,7 +2373,17 @@ static void setup_qr_perspective(struct quirc *q, int index)
          sizeof(rect[0]));
   perspective_setup(qr->c, rect, qr->grid_size - 7, qr->grid_size - 7);
 
-  jiggle_perspective(q, index);
+  /* A fitted transform only needs polishing: the features it was fitted
+   * to lie on the edges of modules, while the fitness samples their
+   * middles.
+   */
+  if (q->refinement == QUIRC_REFINE_FIT && !fit_perspective(q, index))
+  {
+    jiggle_perspective(q, index, 2, QUIRC_FIX(0.01), 1);
+    return;
+  }
+
+  jiggle_perspective(q, index, 5, QUIRC_FIX(0.02), 0);
 }
 
 /* Rotate the capstone with so that corner 0 is the leftmost with respect
@@ -990,7 +2416,7 @@ static void rotate_capstone(struct quirc_capstone *cap,
     memcpy(&copy[j], &cap->corners[(j + best) % 4],
            sizeof(copy[j]));
   memcpy(cap->corners, copy, sizeof(cap->corners));
-  perspective_setup(cap->c, cap->corners, 7.0, 7.0);
+  perspective_setup(cap->c, cap->corners, 7, 7);
 }
 
 static void record_qr_grid(struct quirc *q, int a, int b, int c)
@@ -1050,6 +2476,10 @@ static void record_qr_grid(struct quirc *q, int a, int b, int c)
   if (measure_timing_pattern(q, qr_index) < 0)
     goto fail;
 
+  /* A noisy timing scan can read more modules than any version has. */
+  if (qr->grid_size > QUIRC_MAX_VERSION * 4 + 17)
+    goto fail;
+
   /* Make an estimate based for the alignment pattern based on extending
      * lines from capstones A and C.
      */
@@ -1083,12 +2513,19 @@ static void record_qr_grid(struct quirc *q, int a, int b, int c)
       psd.scores[0] = -hd.y * qr->align.x +
                       hd.x * qr->align.y;
 
-      flood_fill_seed(q, reg->seed.x, reg->seed.y,
-                      qr->align_region, QUIRC_PIXEL_BLACK,
-                      NULL, NULL, 0);
-      flood_fill_seed(q, reg->seed.x, reg->seed.y,
-                      QUIRC_PIXEL_BLACK, qr->align_region,
-                      find_leftmost_to_line, &psd, 0);
+      if (q->label_runs)
+      {
+        region_runs(q, qr->align_region, find_leftmost_to_line, &psd);
+      }
+      else
+      {
+        flood_fill_seed(q, reg->seed.x, reg->seed.y,
+                        qr->align_region, QUIRC_PIXEL_BLACK,
+                        NULL, NULL, 0);
+        flood_fill_seed(q, reg->seed.x, reg->seed.y,
+                        QUIRC_PIXEL_BLACK, qr->align_region,
+                        find_leftmost_to_line, &psd, 0);
+      }
     }
   }
 
@@ -1107,7 +2544,7 @@ fail:
 struct neighbour
 {
   int index;
-  float distance;
+  quirc_coord_t distance;
 } __attribute__((aligned(8)));
 
 struct neighbour_list
@@ -1121,7 +2558,7 @@ static void test_neighbours(struct quirc *q, int i,
                             const struct neighbour_list *vlist)
 {
   int j, k;
-  float best_score = 0.0;
+  quirc_coord_t best_score = 0;
   int best_h = -1, best_v = -1;
 
   /* Test each possible grouping */
@@ -1130,9 +2567,10 @@ static void test_neighbours(struct quirc *q, int i,
     {
       const struct neighbour *hn = &hlist->n[j];
       const struct neighbour *vn = &vlist->n[k];
-      float score = fast_fabsf(1.0 - hn->distance / vn->distance);
+      quirc_coord_t score =
+          QUIRC_ABS(QUIRC_FIX(1.0) - QUIRC_DIV(hn->distance, vn->distance));
 
-      if (score > 2.5)
+      if (score > QUIRC_FIX(2.5))
         continue;
 
       if (best_h < 0 || score < best_score)
@@ -1168,17 +2606,17 @@ static void test_grouping(struct quirc *q, int i)
   for (j = 0; j < q->num_capstones; j++)
   {
     struct quirc_capstone *c2 = &q->capstones[j];
-    float u, v;
+    quirc_coord_t u, v;
 
     if (i == j || c2->qr_grid >= 0)
       continue;
 
     perspective_unmap(c1->c, &c2->center, &u, &v);
 
-    u = fast_fabsf(u - 3.5);
-    v = fast_fabsf(v - 3.5);
+    u = QUIRC_ABS(u - QUIRC_FIX(3.5));
+    v = QUIRC_ABS(v - QUIRC_FIX(3.5));
 
-    if (u < 0.2 * v)
+    if (u < QUIRC_MUL(QUIRC_FIX(0.2), v))
     {
       struct neighbour *n = &hlist.n[hlist.count++];
 
@@ -1186,7 +2624,7 @@ static void test_grouping(struct quirc *q, int i)
       n->distance = v;
     }
 
-    if (v < 0.2 * u)
+    if (v < QUIRC_MUL(QUIRC_FIX(0.2), u))
     {
       struct neighbour *n = &vlist.n[vlist.count++];
 
@@ -1203,21 +2641,335 @@ static void test_grouping(struct quirc *q, int i)
 
 static void pixels_setup(struct quirc *q)
 {
+  /* With byte-sized pixels the image is binarised in place. Otherwise
+   * threshold_row() converts straight from q->image into q->pixels.
+   * An external image is never written to: its binarised copy goes into
+   * q->image instead.
+   */
   if (sizeof(*q->image) == sizeof(*q->pixels))
-  {
     q->pixels = (quirc_pixel_t *)q->image;
+
+  if (!q->source)
+  {
+    q->source = q->image;
+    q->source_stride = q->image_w;
   }
-  else
+
+  /* A region is packed into the top of q->pixels. Binarising the image
+   * in place stays safe: every pixel is written no later in the buffer
+   * than where it was read from.
+   */
+  q->source += q->region_y * q->source_stride + q->region_x;
+
+  q->use_bits = q->bit_plane && !bits_begin(q);
+}
+
+/* Test the queued finder pattern candidates, then scan the rows from
+ * scan_from on, whose candidates did not fit in the queue.
+ */
+static void test_finder_hits(struct quirc *q, int scan_from)
+{
+  int i, y;
+
+  for (i = 0; i < q->num_finder_hits; i++)
+  {
+    const struct quirc_finder_hit *hit = &q->finder_hits[i];
+    int pb[5];
+    int j;
+
+    for (j = 0; j < 5; j++)
+      pb[j] = hit->pb[j];
+
+    test_capstone(q, hit->x, hit->y, pb);
+  }
+
+  for (y = scan_from; y < q->h; y++)
+    finder_scan(q, y, 0);
+}
+
+/* Separate passes: threshold the whole image, label it, then scan every
+ * row for finder patterns.
+ */
+static void identify_separate(struct quirc *q)
+{
+  int i;
+
+  quirc_profile_begin(QUIRC_STAGE_THRESHOLD);
+  threshold(q);
+  quirc_profile_end(QUIRC_STAGE_THRESHOLD);
+
+  quirc_profile_begin(QUIRC_STAGE_LABEL);
+  label_regions(q, 0);
+  quirc_profile_end(QUIRC_STAGE_LABEL);
+
+  quirc_profile_begin(QUIRC_STAGE_FINDER_SCAN);
+  for (i = 0; i < q->h; i++)
+  {
+    finder_scan(q, i, 0);
+  }
+  quirc_profile_end(QUIRC_STAGE_FINDER_SCAN);
+}
+
+/* Fused identification pass. Each row is scanned for finder patterns
+ * straight after it has been thresholded, while it is still in cache,
+ * so the frame is streamed through once instead of twice.
+ *
+ * test_capstone() flood fills whole regions, which may reach rows that
+ * have not been thresholded yet, so candidates are queued and tested
+ * afterwards in the order the separate passes would have found them.
+ * Labelling regions never changes whether a pixel reads as dark, so the
+ * outcome is identical. Should the queue fill up, the remaining rows are
+ * thresholded first and scanned the ordinary way.
+ */
+static void identify_fused(struct quirc *q)
+{
+  struct threshold_state ts;
+  int y = 0;
+  int i;
+
+  quirc_profile_begin(QUIRC_STAGE_THRESHOLD);
+  threshold_begin(q, &ts, 0);
+  q->num_finder_hits = 0;
+
+  for (y = 0; y < q->h; y++)
+  {
+    const int mark = q->num_finder_hits;
+
+    threshold_rle_row(q, &ts, y);
+
+    if (finder_scan(q, y, 1) < 0)
+    {
+      q->num_finder_hits = mark;
+      for (i = y + 1; i < q->h; i++)
+        threshold_rle_row(q, &ts, i);
+      break;
+    }
+  }
+  quirc_profile_end(QUIRC_STAGE_THRESHOLD);
+
+  quirc_profile_begin(QUIRC_STAGE_LABEL);
+  label_regions(q, 0);
+  quirc_profile_end(QUIRC_STAGE_LABEL);
+
+  quirc_profile_begin(QUIRC_STAGE_FINDER_SCAN);
+  test_finder_hits(q, y);
+  quirc_profile_end(QUIRC_STAGE_FINDER_SCAN);
+}
+
+/************************************************************************
+ * Banded identification
+ *
+ * The image is cut into horizontal bands which are thresholded, run
+ * encoded, scanned for finder patterns and run labelled in parallel
+ * (see quirc_set_threads). Every band but the first works on a struct
+ * quirc of its own, whose runs and finder hits are then appended to
+ * the main one in order. Joining the first row of each band to the row
+ * above completes the labelling, and the queued candidates are tested
+ * as after a fused pass, so capstones straddling a border are found as
+ * usual.
+ */
+
+/* Point the struct quirc of a band at the current image and make sure
+ * its scratch buffers fit. Returns -1 if out of memory.
+ */
+static int band_begin(struct quirc *q, struct quirc_band *band)
+{
+  struct quirc *b = band->q;
+
+  if (b->image_w != q->image_w || b->image_h != q->image_h)
+  {
+    if (b->threshold_sums)
+      free(b->threshold_sums);
+    if (b->threshold_rows)
+      free(b->threshold_rows);
+    if (b->bit_row)
+      free(b->bit_row);
+    if (b->row_runs)
+      free(b->row_runs);
+    b->threshold_sums = NULL;
+    b->threshold_rows = NULL;
+    b->bit_row = NULL;
+    b->row_runs = NULL;
+    b->image_w = q->image_w;
+    b->image_h = q->image_h;
+  }
+
+  if (!b->threshold_sums)
+    b->threshold_sums = ps_malloc(b->image_w * sizeof(*b->threshold_sums));
+  if (!b->threshold_rows)
+    b->threshold_rows =
+        ps_malloc((quirc_threshold_radius(b->image_w) + 1) * b->image_w);
+  if (q->use_bits && !b->bit_row)
+    b->bit_row = heap_caps_malloc(b->image_w * sizeof(*b->bit_row),
+                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!b->threshold_sums || !b->threshold_rows ||
+      (q->use_bits && !b->bit_row))
+    return -1;
+
+  b->w = q->w;
+  b->h = q->h;
+  b->source = q->source;
+  b->source_stride = q->source_stride;
+  b->pixels = q->pixels;
+  b->threshold_method = q->threshold_method;
+  b->use_bits = q->use_bits;
+  b->bits = q->bits;
+  b->bit_stride = q->bit_stride;
+  b->label_runs = q->label_runs;
+  b->rle = !rle_begin(b);
+
+  return 0;
+}
+
+/* Process the rows of one band. The first row of any band but the top
+ * one is left unjoined, as the runs above it are in another band.
+ */
+static void band_run(void *arg)
+{
+  struct quirc_band *band = arg;
+  struct quirc *q = band->q;
+  struct threshold_state ts;
+  int y;
+
+  threshold_begin(q, &ts, band->y0);
+  q->num_finder_hits = 0;
+  band->scan_from = band->y1;
+
+  for (y = band->y0; y < band->y1; y++)
+  {
+    const int mark = q->num_finder_hits;
+
+    threshold_rle_row(q, &ts, y);
+
+    if (band->scan_from == band->y1 && finder_scan(q, y, 1) < 0)
+    {
+      q->num_finder_hits = mark;
+      band->scan_from = y;
+    }
+
+    if (q->label_runs && q->rle && (y > band->y0 || !y))
+      label_row(q, y);
+  }
+}
+
+/* Append the runs of a band to those of the bands above it, renumbered,
+ * and join its first row to the last row of the band above.
+ */
+static void band_merge_runs(struct quirc *q, const struct quirc_band *band)
+{
+  const struct quirc *b = band->q;
+  const int offset = q->num_runs;
+  int i;
+
+  if (!q->rle)
+    return;
+
+  if (!b->rle)
+  {
+    q->rle = 0;
+    return;
+  }
+
+  if (q->num_runs + b->num_runs > q->max_runs)
   {
-    int x, y;
-    for (y = 0; y < q->h; y++)
+    struct quirc_run *runs = grow_array(q->runs, q->num_runs, &q->max_runs,
+                                        sizeof(*runs),
+                                        q->num_runs + b->num_runs);
+
+    if (!runs)
+    {
+      q->rle = 0;
+      return;
+    }
+    q->runs = runs;
+  }
+
+  for (i = 0; i < b->num_runs; i++)
+  {
+    q->runs[offset + i] = b->runs[i];
+    q->runs[offset + i].label += offset;
+  }
+
+  for (i = band->y0 + 1; i <= band->y1; i++)
+    q->row_runs[i] = b->row_runs[i] + offset;
+
+  q->num_runs += b->num_runs;
+
+  if (q->label_runs)
+    label_row(q, band->y0);
+}
+
+/* Queue the finder hits of the other bands behind those of the first,
+ * stopping where the unbanded fused pass would have run out of room.
+ * Returns the first row left to an ordinary scan.
+ */
+static int band_merge_hits(struct quirc *q)
+{
+  int scan_from = q->bands[0].scan_from;
+  int i, k;
+
+  for (i = 1; i < q->num_bands && scan_from == q->bands[i].y0; i++)
+  {
+    const struct quirc *b = q->bands[i].q;
+
+    scan_from = q->bands[i].scan_from;
+
+    for (k = 0; k < b->num_finder_hits; k++)
     {
-      for (x = 0; x < q->w; x++)
+      if (q->num_finder_hits >= QUIRC_MAX_FINDER_HITS)
       {
-        q->pixels[y * q->w + x] = q->image[y * q->w + x];
+        /* The row which did not fit is scanned again in full */
+        scan_from = b->finder_hits[k].y;
+        while (q->num_finder_hits &&
+               q->finder_hits[q->num_finder_hits - 1].y == scan_from)
+          q->num_finder_hits--;
+        break;
       }
+
+      q->finder_hits[q->num_finder_hits++] = b->finder_hits[k];
     }
   }
+
+  return scan_from;
+}
+
+/* Returns -1, having done nothing, if the bands could not be set up. */
+static int identify_banded(struct quirc *q)
+{
+  const int n = q->num_bands;
+  int i;
+
+  for (i = 0; i < n; i++)
+  {
+    q->bands[i].y0 = q->h * i / n;
+    q->bands[i].y1 = q->h * (i + 1) / n;
+
+    if (i && band_begin(q, &q->bands[i]) < 0)
+      return -1;
+  }
+
+  quirc_profile_begin(QUIRC_STAGE_THRESHOLD);
+  for (i = 1; i < n; i++)
+    quirc_thread_run(q->bands[i].thread, band_run, &q->bands[i]);
+
+  band_run(&q->bands[0]);
+
+  for (i = 1; i < n; i++)
+    quirc_thread_wait(q->bands[i].thread);
+  quirc_profile_end(QUIRC_STAGE_THRESHOLD);
+
+  quirc_profile_begin(QUIRC_STAGE_LABEL);
+  for (i = 1; i < n; i++)
+    band_merge_runs(q, &q->bands[i]);
+
+  label_regions(q, q->h);
+  quirc_profile_end(QUIRC_STAGE_LABEL);
+
+  quirc_profile_begin(QUIRC_STAGE_FINDER_SCAN);
+  test_finder_hits(q, band_merge_hits(q));
+  quirc_profile_end(QUIRC_STAGE_FINDER_SCAN);
+
+  return 0;
 }
 
 uint8_t *quirc_begin(struct quirc *q, int *w, int *h)
@@ -1225,6 +2977,11 @@ uint8_t *quirc_begin(struct quirc *q, int *w, int *h)
   q->num_regions = QUIRC_PIXEL_REGION;
   q->num_capstones = 0;
   q->num_grids = 0;
+  q->source = NULL;
+  q->w = q->image_w;
+  q->h = q->image_h;
+  q->region_x = 0;
+  q->region_y = 0;
 
   if (w)
     *w = q->w;
@@ -1234,21 +2991,79 @@ uint8_t *quirc_begin(struct quirc *q, int *w, int *h)
   return q->image;
 }
 
+void quirc_begin_external(struct quirc *q, const uint8_t *image, int stride)
+{
+  quirc_begin(q, NULL, NULL);
+
+  q->source = image;
+  q->source_stride = stride;
+}
+
 void quirc_end(struct quirc *q)
 {
+  const int external = q->source != NULL;
+  int banded;
   int i;
-  pixels_setup(q);
-  threshold(q);
 
-  for (i = 0; i < q->h; i++)
+  quirc_profile_begin(QUIRC_STAGE_PIXELS_SETUP);
+  pixels_setup(q);
+  q->rle = !rle_begin(q);
+  q->label_runs = q->labelling == QUIRC_LABEL_RUNS || q->use_bits;
+  q->regions = q->region_table;
+  quirc_profile_end(QUIRC_STAGE_PIXELS_SETUP);
+
+  /* Bands may only be used if no band overwrites source rows which
+   * another one still has to read.
+   */
+  banded = q->num_bands > 1 && q->h >= q->num_bands &&
+           (external || q->use_bits || (void *)q->pixels != (void *)q->image);
+
+  if (!banded || identify_banded(q) < 0)
   {
-    finder_scan(q, i);
+    if (q->fused_scan)
+      identify_fused(q);
+    else
+      identify_separate(q);
   }
 
+  quirc_profile_begin(QUIRC_STAGE_TEST_GROUPING);
   for (i = 0; i < q->num_capstones; i++)
   {
     test_grouping(q, i);
   }
+  quirc_profile_end(QUIRC_STAGE_TEST_GROUPING);
+
+  /* The external image is only borrowed for this call */
+  q->source = NULL;
+}
+
+struct check_grid
+{
+  const struct quirc *q;
+  const struct quirc_grid *qr;
+};
+
+/* Samples a cell at its centre, as quirc_extract() does */
+static int check_cell(void *arg, int x, int y)
+{
+  const struct check_grid *g = arg;
+  struct quirc_point p;
+
+  perspective_map(g->qr->c, QUIRC_INT(x) + QUIRC_FIX(0.5),
+                  QUIRC_INT(y) + QUIRC_FIX(0.5), &p);
+  return read_cell(g->q, &p) > 0;
+}
+
+quirc_decode_error_t quirc_check(const struct quirc *q, int index)
+{
+  struct check_grid g;
+
+  if (index < 0 || index >= q->num_grids)
+    return QUIRC_ERROR_INVALID_GRID_SIZE;
+
+  g.q = q;
+  g.qr = &q->grids[index];
+  return quirc_check_info(g.qr->grid_size, check_cell, &g);
 }
 
 void quirc_extract(const struct quirc *q, int index,
@@ -1257,27 +3072,43 @@ void quirc_extract(const struct quirc *q, int index,
   const struct quirc_grid *qr = &q->grids[index];
   int y;
   int i = 0;
+  int k;
 
   if (index < 0 || index > q->num_grids)
     return;
 
   memset(code, 0, sizeof(*code));
 
-  perspective_map(qr->c, 0.0, 0.0, &code->corners[0]);
-  perspective_map(qr->c, qr->grid_size, 0.0, &code->corners[1]);
-  perspective_map(qr->c, qr->grid_size, qr->grid_size,
+  perspective_map(qr->c, QUIRC_INT(0), QUIRC_INT(0), &code->corners[0]);
+  perspective_map(qr->c, QUIRC_INT(qr->grid_size), QUIRC_INT(0),
+                  &code->corners[1]);
+  perspective_map(qr->c, QUIRC_INT(qr->grid_size), QUIRC_INT(qr->grid_size),
                   &code->corners[2]);
-  perspective_map(qr->c, 0.0, qr->grid_size, &code->corners[3]);
+  perspective_map(qr->c, QUIRC_INT(0), QUIRC_INT(qr->grid_size),
+                  &code->corners[3]);
+
+  for (k = 0; k < 4; k++)
+  {
+    code->corners[k].x += q->region_x;
+    code->corners[k].y += q->region_y;
+  }
 
   code->size = qr->grid_size;
 
   for (y = 0; y < qr->grid_size; y++)
   {
+    struct perspective_walk w;
     int x;
 
+    perspective_walk_start(&w, qr->c, QUIRC_INT(y) + QUIRC_FIX(0.5),
+                           QUIRC_INT(1));
+
     for (x = 0; x < qr->grid_size; x++)
     {
-      if (read_cell(q, index, x, y) > 0)
+      struct quirc_point p;
+
+      perspective_walk_next(&w, QUIRC_INT(x) + QUIRC_FIX(0.5), &p);
+      if (read_cell(q, &p) > 0)
         code->cell_bitmap[i >> 3] |= (1 << (i & 7));
 
       i++;
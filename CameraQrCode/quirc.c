@@ -33,17 +33,61 @@ struct quirc *quirc_new(void)
     return NULL;
 
   memset(q, 0, sizeof(*q));
+  q->regions = q->region_table;
+  q->num_bands = 1;
+  q->bands[0].q = q;
   return q;
 }
 
+/* Stop the thread of a band and free what its struct quirc owns. The
+ * image fields were only borrowed from the main one.
+ */
+static void band_destroy(struct quirc_band *band)
+{
+  struct quirc *b = band->q;
+
+  quirc_thread_destroy(band->thread);
+
+  if (b->threshold_sums)
+    free(b->threshold_sums);
+  if (b->threshold_rows)
+    free(b->threshold_rows);
+  if (b->bit_row)
+    free(b->bit_row);
+  if (b->row_runs)
+    free(b->row_runs);
+  if (b->runs)
+    free(b->runs);
+  free(b);
+}
+
 void quirc_destroy(struct quirc *q)
 {
+  while (q->num_bands > 1)
+    band_destroy(&q->bands[--q->num_bands]);
+
   if (q->image)
     if (q->image)
       free(q->image);
   if (sizeof(*q->image) != sizeof(*q->pixels))
     if (q->pixels)
       free(q->pixels);
+  if (q->threshold_sums)
+    free(q->threshold_sums);
+  if (q->threshold_rows)
+    free(q->threshold_rows);
+  if (q->flood_fill_stack)
+    free(q->flood_fill_stack);
+  if (q->row_runs)
+    free(q->row_runs);
+  if (q->runs)
+    free(q->runs);
+  if (q->run_regions)
+    free(q->run_regions);
+  if (q->bits)
+    free(q->bits);
+  if (q->bit_row)
+    free(q->bit_row);
 
   if (q)
     free(q);
@@ -52,34 +96,175 @@ void quirc_destroy(struct quirc *q)
 //static quirc_pixel_t img_buf[320*240];
 int quirc_resize(struct quirc *q, int w, int h)
 {
-  if (q->image)
-  {
-    free(q->image);
-  }
-  uint8_t *new_image = ps_malloc(w * h);
+  uint8_t *new_image;
+  uint32_t *new_sums;
+  uint8_t *new_rows;
+  quirc_pixel_t *new_pixels = NULL;
+  xylf_t *new_stack;
 
-  if (!new_image)
+  /* Allocate everything before letting go of anything, so that a
+   * failure leaves the recognizer as it was.
+   */
+  new_image = ps_malloc(w * h);
+  new_sums = ps_malloc(w * sizeof(*q->threshold_sums));
+  new_rows = ps_malloc((quirc_threshold_radius(w) + 1) * w);
+  /* Enough for the deepest fill in typical frames; the stack doubles
+   * on demand.
+   */
+  new_stack = ps_malloc((w + h) * sizeof(*q->flood_fill_stack));
+  if (sizeof(*q->image) != sizeof(*q->pixels)) //should gray, 1==1
+    new_pixels = ps_malloc(w * h * sizeof(quirc_pixel_t));
+
+  if (!new_image || !new_sums || !new_rows || !new_stack ||
+      (sizeof(*q->image) != sizeof(*q->pixels) && !new_pixels))
+  {
+    free(new_image);
+    free(new_sums);
+    free(new_rows);
+    free(new_stack);
+    free(new_pixels);
     return -1;
+  }
 
+  if (q->image)
+    free(q->image);
+  if (q->threshold_sums)
+    free(q->threshold_sums);
+  if (q->threshold_rows)
+    free(q->threshold_rows);
   if (sizeof(*q->image) != sizeof(*q->pixels))
-  { //should gray, 1==1
-    size_t new_size = w * h * sizeof(quirc_pixel_t);
+  {
     if (q->pixels)
       free(q->pixels);
-    quirc_pixel_t *new_pixels = ps_malloc(new_size);
-    if (!new_pixels)
-    {
-      free(new_image);
-      return -1;
-    }
     q->pixels = new_pixels;
   }
   q->image = new_image;
+  q->threshold_sums = new_sums;
+  q->threshold_rows = new_rows;
+
+  if (q->flood_fill_stack)
+    free(q->flood_fill_stack);
+  q->flood_fill_stack = new_stack;
+  q->flood_fill_size = w + h;
+  q->flood_fill_peak = 0;
+
+  /* The run-based labeller allocates on first use */
+  if (q->row_runs)
+    free(q->row_runs);
+  q->row_runs = NULL;
+
+  /* So is the bit plane */
+  if (q->bits)
+    free(q->bits);
+  if (q->bit_row)
+    free(q->bit_row);
+  q->bits = NULL;
+  q->bit_row = NULL;
+
   q->w = w;
   q->h = h;
+  q->image_w = w;
+  q->image_h = h;
+  q->region_x = 0;
+  q->region_y = 0;
+  return 0;
+}
+
+void quirc_set_threshold_method(struct quirc *q,
+                                quirc_threshold_method_t method)
+{
+  q->threshold_method = method;
+}
+
+void quirc_set_bit_plane(struct quirc *q, int enable)
+{
+  q->bit_plane = enable;
+}
+
+void quirc_set_fused_scan(struct quirc *q, int enable)
+{
+  q->fused_scan = enable;
+}
+
+void quirc_set_refinement(struct quirc *q, quirc_refinement_t refinement)
+{
+  q->refinement = refinement;
+}
+
+int quirc_set_threads(struct quirc *q, int threads)
+{
+  if (threads < 1)
+    threads = 1;
+  if (threads > QUIRC_MAX_THREADS)
+    threads = QUIRC_MAX_THREADS;
+
+  while (q->num_bands > threads)
+    band_destroy(&q->bands[--q->num_bands]);
+
+  while (q->num_bands < threads)
+  {
+    struct quirc_band *band = &q->bands[q->num_bands];
+
+    /* Band buffers are allocated by quirc_end(), once the size is known */
+    band->q = ps_malloc(sizeof(*band->q));
+    if (!band->q)
+      return -1;
+    memset(band->q, 0, sizeof(*band->q));
+
+    band->thread = quirc_thread_new(q->num_bands);
+    if (!band->thread)
+    {
+      free(band->q);
+      return -1;
+    }
+
+    q->num_bands++;
+  }
+
   return 0;
 }
 
+void quirc_set_region(struct quirc *q, int x, int y, int w, int h)
+{
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if (x > q->image_w - 1)
+    x = q->image_w - 1;
+  if (y > q->image_h - 1)
+    y = q->image_h - 1;
+  if (w > q->image_w - x)
+    w = q->image_w - x;
+  if (h > q->image_h - y)
+    h = q->image_h - y;
+  if (w < 1)
+    w = 1;
+  if (h < 1)
+    h = 1;
+
+  q->region_x = x;
+  q->region_y = y;
+  q->w = w;
+  q->h = h;
+}
+
+void quirc_set_labelling(struct quirc *q, quirc_labelling_t labelling)
+{
+  q->labelling = labelling;
+}
+
+int quirc_flood_fill_peak(const struct quirc *q)
+{
+  return q->flood_fill_peak;
+}
+
 int quirc_count(const struct quirc *q)
 {
   return q->num_grids;
@@ -93,7 +278,8 @@ static const char *const error_table[] = {
     [QUIRC_ERROR_DATA_ECC] = "ECC failure",
     [QUIRC_ERROR_UNKNOWN_DATA_TYPE] = "Unknown data type",
     [QUIRC_ERROR_DATA_OVERFLOW] = "Data overflow",
-    [QUIRC_ERROR_DATA_UNDERFLOW] = "Data underflow"};
+    [QUIRC_ERROR_DATA_UNDERFLOW] = "Data underflow",
+    [QUIRC_ERROR_OUT_OF_MEMORY] = "Out of memory"};
 
 const char *quirc_strerror(quirc_decode_error_t err)
 {
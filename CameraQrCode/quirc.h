@@ -45,6 +45,108 @@ extern "C"
  */
   int quirc_resize(struct quirc *q, int w, int h);
 
+  /* These are the binarisation methods which quirc_end() can use to
+ * separate dark modules from the light background.
+ */
+  typedef enum
+  {
+    /* Two moving averages run in opposite directions along each row,
+     * alternating direction from row to row. This is the default.
+     */
+    QUIRC_THRESHOLD_SERPENTINE = 0,
+
+    /* Mean of a square window centred on each pixel, maintained with
+     * running row and column sums. Costs one multiply per pixel and
+     * no divisions.
+     */
+    QUIRC_THRESHOLD_BOX
+  } quirc_threshold_method_t;
+
+  /* Select the binarisation method used by subsequent calls to
+ * quirc_end().
+ */
+  void quirc_set_threshold_method(struct quirc *q,
+                                  quirc_threshold_method_t method);
+
+  /* These are the ways quirc_end() can tell dark regions apart. */
+  typedef enum
+  {
+    /* Regions are flood filled with their number in the binarised
+     * image when first needed. At most QUIRC_MAX_REGIONS are labelled
+     * per image. This is the default.
+     */
+    QUIRC_LABEL_FLOOD_FILL = 0,
+
+    /* All dark regions are labelled in one sweep over the runs of each
+     * row, joining overlapping runs with union-find. Labels are kept
+     * beside the image, so there is no limit on their number, at the
+     * cost of memory for the runs.
+     */
+    QUIRC_LABEL_RUNS
+  } quirc_labelling_t;
+
+  /* Choose how regions are labelled. Takes effect from the next call to
+ * quirc_end(). If the run-based labeller runs out of memory, that
+ * image is labelled by flood fill instead.
+ */
+  void quirc_set_labelling(struct quirc *q, quirc_labelling_t labelling);
+
+  /* If enabled, quirc_end() keeps the binarised image as a plane of one
+ * bit per pixel, allocated from internal RAM, instead of a byte per
+ * pixel beside the image. Regions are then always labelled from row
+ * runs (see quirc_set_labelling). Should the plane not fit, the image is
+ * processed the ordinary way. Disabled by default.
+ */
+  void quirc_set_bit_plane(struct quirc *q, int enable);
+
+  /* If enabled, quirc_end() scans each row for finder patterns as soon
+ * as it has been thresholded instead of making a separate pass over
+ * the whole image. Results are the same either way; the fused pass
+ * touches each pixel once fewer, which matters when the image lives in
+ * slow external RAM. Disabled by default.
+ */
+  void quirc_set_fused_scan(struct quirc *q, int enable);
+
+  /* Split the thresholding, finder scan and run labelling of each image
+ * into horizontal bands, worked on by this many threads at once
+ * including the caller's. On the ESP32 the extra threads are pinned to
+ * the other core. Only images which are not binarised in place are
+ * split: those bound with quirc_begin_external(), or any image once the
+ * bit plane is enabled. Results are the same as without bands for the
+ * box filter. The serpentine filter picks its moving averages up a few
+ * rows above each band, which may flip the odd pixel near a border.
+ * Returns -1 if a thread could not be started, in which case fewer are
+ * used. The default is 1.
+ */
+  int quirc_set_threads(struct quirc *q, int threads);
+
+  /* These are the ways the perspective transform of each grid found is
+ * refined, once it has been set up from the capstones and the
+ * alignment pattern.
+ */
+  typedef enum
+  {
+    /* Each parameter is nudged back and forth by a shrinking step,
+     * keeping every change which makes the timing patterns, capstones
+     * and alignment patterns read better. Takes 81 readings of them all.
+     * This is the default.
+     */
+    QUIRC_REFINE_JIGGLE = 0,
+
+    /* The transform is fitted by least squares to the capstone corners,
+     * the alignment pattern and the module edges of both timing
+     * patterns, then polished by two passes of the above which read
+     * only the centre of each cell. About a tenth of the work. Grids
+     * whose features are too few to fit are refined as above.
+     */
+    QUIRC_REFINE_FIT
+  } quirc_refinement_t;
+
+  /* Choose how grid transforms are refined by subsequent calls to
+ * quirc_end().
+ */
+  void quirc_set_refinement(struct quirc *q, quirc_refinement_t refinement);
+
   /* These functions are used to process images for QR-code recognition.
  * quirc_begin() must first be called to obtain access to a buffer into
  * which the input image should be placed. Optionally, the current
@@ -57,6 +159,24 @@ extern "C"
   uint8_t *quirc_begin(struct quirc *q, int *w, int *h);
   void quirc_end(struct quirc *q);
 
+  /* Instead of copying the image into the buffer returned by
+ * quirc_begin(), a grayscale image owned by the caller may be bound
+ * for the next quirc_end() call. It must be the size last given to
+ * quirc_resize(), with rows stride bytes apart. quirc_end() only reads
+ * from it and releases it before returning, so the caller may reuse
+ * or free the image straight afterwards.
+ */
+  void quirc_begin_external(struct quirc *q, const uint8_t *image,
+                            int stride);
+
+  /* Restrict the next quirc_end() to a w by h rectangle of the image
+ * with its top left corner at (x, y), clipped to the image. Only codes
+ * lying wholly inside it can be found, but their corners are still
+ * given in image coordinates. Call after quirc_begin() or
+ * quirc_begin_external(); quirc_begin() resets to the whole image.
+ */
+  void quirc_set_region(struct quirc *q, int x, int y, int w, int h);
+
   /* This structure describes a location in the input image buffer. */
   struct quirc_point
   {
@@ -74,7 +194,8 @@ extern "C"
     QUIRC_ERROR_DATA_ECC,
     QUIRC_ERROR_UNKNOWN_DATA_TYPE,
     QUIRC_ERROR_DATA_OVERFLOW,
-    QUIRC_ERROR_DATA_UNDERFLOW
+    QUIRC_ERROR_DATA_UNDERFLOW,
+    QUIRC_ERROR_OUT_OF_MEMORY
   } quirc_decode_error_t;
 
   /* Return a string error message for an error code. */
@@ -96,6 +217,9 @@ extern "C"
 #define QUIRC_DATA_TYPE_BYTE 4
 #define QUIRC_DATA_TYPE_KANJI 8
 
+/* Mode of a segment which only changes the ECI assignment */
+#define QUIRC_DATA_TYPE_ECI 7
+
 /* Common character encodings */
 #define QUIRC_ECI_ISO_8859_1 1
 #define QUIRC_ECI_IBM437 2
@@ -158,6 +282,12 @@ extern "C"
     uint32_t eci;
   } __attribute__((aligned(8)));
 
+  /* Return the largest number of spans the region flood fill has had
+ * waiting at once since the last quirc_resize(). Its work stack grows
+ * to fit, so this is a measure of how much memory the fills take.
+ */
+  int quirc_flood_fill_peak(const struct quirc *q);
+
   /* Return the number of QR-codes identified in the last processed
  * image.
  */
@@ -167,10 +297,62 @@ extern "C"
   void quirc_extract(const struct quirc *q, int index,
                      struct quirc_code *code);
 
+  /* Read only the format information of the QR-code specified by the
+ * given index, and its version information from version 7 up, from
+ * the image. Returns an error if neither copy of either can be
+ * corrected, in which case the code is not worth extracting: without
+ * its format, quirc_decode() would fail with the same error. Codes
+ * whose version information is lost in both places are rejected too,
+ * although their data might still have been readable.
+ */
+  quirc_decode_error_t quirc_check(const struct quirc *q, int index);
+
   /* Decode a QR-code, returning the payload data. */
   quirc_decode_error_t quirc_decode(const struct quirc_code *code,
                                     struct quirc_data *data);
 
+  /* Scratch space for decoding, about 26 kB, which quirc_decode()
+ * allocates and frees again on every call. One decoder can be reused
+ * for any number of codes, by one caller at a time. Returns NULL if
+ * there is not enough memory.
+ */
+  struct quirc_decoder;
+
+  struct quirc_decoder *quirc_decoder_new(void);
+  void quirc_decoder_destroy(struct quirc_decoder *d);
+
+  /* Decode a QR-code as quirc_decode() does, using the given decoder's
+ * scratch space.
+ */
+  quirc_decode_error_t quirc_decode_with(struct quirc_decoder *d,
+                                         const struct quirc_code *code,
+                                         struct quirc_data *data);
+
+  /* One segment of a payload: a run of characters in one mode, or for
+ * QUIRC_DATA_TYPE_ECI a new ECI assignment with no characters. The
+ * characters are as they would be in quirc_data's payload, with a nul
+ * terminator after them, and stay valid until the callback returns.
+ */
+  struct quirc_segment
+  {
+    int data_type;
+    uint32_t eci;
+    const uint8_t *data;
+    int len;
+  };
+
+  typedef void (*quirc_segment_fn)(void *arg, const struct quirc_segment *seg);
+
+  /* Decode a QR-code, handing each segment of its payload to fn as it
+ * is read instead of collecting them into a quirc_data. Segments are
+ * only read once every block has been corrected. If the payload turns
+ * out to be malformed part way, the segments before that have already
+ * been handed over when the error is returned.
+ */
+  quirc_decode_error_t quirc_decode_segments(struct quirc_decoder *d,
+                                             const struct quirc_code *code,
+                                             quirc_segment_fn fn, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,10 @@
 
 #include "quirc.h"
 
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
 #define QUIRC_PIXEL_WHITE 0
 #define QUIRC_PIXEL_BLACK 1
 #define QUIRC_PIXEL_REGION 2
@@ -30,8 +34,76 @@
 #define QUIRC_MAX_CAPSTONES 32
 #define QUIRC_MAX_GRIDS 8
 
+#ifndef QUIRC_MAX_FINDER_HITS
+#define QUIRC_MAX_FINDER_HITS 256
+#endif
+
 #define QUIRC_PERSPECTIVE_PARAMS 8
 
+/* The ESP32-C3 has no FPU */
+#if defined(CONFIG_IDF_TARGET_ESP32C3) && !defined(QUIRC_FIXED_POINT)
+#define QUIRC_FIXED_POINT
+#endif
+
+/* Perspective transforms, and the grid coordinates they map, are kept
+ * in quirc_coord_t. Building with QUIRC_FIXED_POINT makes that Q16.16
+ * fixed point, for cores without an FPU such as the ESP32-C3; the
+ * geometry then needs no floating point beyond the least-squares fit
+ * of quirc_set_refinement(). The exceptions are c[6] and c[7] of a
+ * transform, which scale its denominator per grid cell and are far
+ * smaller than one: they are Q2.30. QUIRC_FIX() converts a number,
+ * QUIRC_FIX_DEN() one of those two, and QUIRC_INT() an integer.
+ */
+#ifdef QUIRC_FIXED_POINT
+typedef int32_t quirc_coord_t;
+
+#define QUIRC_FIX_SHIFT 16
+#define QUIRC_DEN_SHIFT 30
+#define QUIRC_FIX(x) ((quirc_coord_t)((x) * 65536.0 + ((x) < 0 ? -0.5 : 0.5)))
+#define QUIRC_FIX_DEN(x) \
+  ((quirc_coord_t)((x) * 1073741824.0 + ((x) < 0 ? -0.5 : 0.5)))
+#define QUIRC_INT(n) ((quirc_coord_t)((n) * 65536))
+#define QUIRC_MUL(a, b) ((quirc_coord_t)(((int64_t)(a) * (b)) >> QUIRC_FIX_SHIFT))
+#define QUIRC_DIV(a, b) ((quirc_coord_t)(((int64_t)(a) << QUIRC_FIX_SHIFT) / (b)))
+#else
+typedef float quirc_coord_t;
+
+#define QUIRC_FIX(x) (x)
+#define QUIRC_FIX_DEN(x) (x)
+#define QUIRC_INT(n) ((quirc_coord_t)(n))
+#define QUIRC_MUL(a, b) ((a) * (b))
+#define QUIRC_DIV(a, b) ((a) / (b))
+#endif
+
+#define QUIRC_ABS(a) ((a) < 0 ? -(a) : (a))
+
+#ifndef QUIRC_MAX_THREADS
+#define QUIRC_MAX_THREADS 4
+#endif
+
+/* Adaptive threshold window: the moving averages (and the box filter
+ * side) span 1/THRESHOLD_S_DEN of the image width, and a pixel is dark
+ * if it is THRESHOLD_T percent below the local mean.
+ */
+#define THRESHOLD_S_MIN 1
+#define THRESHOLD_S_DEN 8
+#define THRESHOLD_T 5
+
+/* Rows above a band over which the serpentine filter's averages are
+ * warmed up (see quirc_set_threads).
+ */
+#define THRESHOLD_HALO 2
+
+static inline int quirc_threshold_radius(int w)
+{
+  int s = w / THRESHOLD_S_DEN;
+
+  if (s < THRESHOLD_S_MIN)
+    s = THRESHOLD_S_MIN;
+
+  return s / 2;
+}
+
 #if QUIRC_MAX_REGIONS < UINT8_MAX
 typedef uint8_t quirc_pixel_t;
 #elif QUIRC_MAX_REGIONS < UINT16_MAX
@@ -45,6 +117,58 @@ struct quirc_region
   struct quirc_point seed;
   int count;
   int capstone;
+
+  /* Run-based labelling only: the region's runs all lie between these
+   * indices into q->runs.
+   */
+  int run_first;
+  int run_last;
+} __attribute__((aligned(8)));
+
+/* A horizontal run of dark pixels. While labelling is in progress,
+ * label is the index of a run it is connected to (no greater than its
+ * own), afterwards the number of its region.
+ */
+struct quirc_run
+{
+  int16_t y;
+  int16_t left;
+  int16_t right;
+  int32_t label;
+} __attribute__((aligned(4)));
+
+/* A row which matched the finder pattern ratio, waiting to be checked
+ * by test_capstone() during a fused scan.
+ */
+struct quirc_finder_hit
+{
+  int16_t x;
+  int16_t y;
+  int16_t pb[5];
+} __attribute__((aligned(8)));
+
+/* A span of the flood fill whose neighbours are still to be scanned:
+ * row y from l to r, entered at x.
+ */
+typedef struct xylf
+{
+  int16_t x, y, l, r;
+} __attribute__((aligned(8)))
+xylf_t;
+
+struct quirc_thread;
+
+/* A horizontal band of the image, rows y0 up to y1, for banded
+ * identification. Finder pattern candidates on rows from scan_from on
+ * did not fit in its queue and are left to a scan of the whole image.
+ */
+struct quirc_band
+{
+  struct quirc *q;
+  struct quirc_thread *thread;
+  int y0;
+  int y1;
+  int scan_from;
 } __attribute__((aligned(8)));
 
 struct quirc_capstone
@@ -54,7 +178,7 @@ struct quirc_capstone
 
   struct quirc_point corners[4];
   struct quirc_point center;
-  float c[QUIRC_PERSPECTIVE_PARAMS];
+  quirc_coord_t c[QUIRC_PERSPECTIVE_PARAMS];
 
   int qr_grid;
 } __attribute__((aligned(8)));
@@ -75,7 +199,7 @@ struct quirc_grid
 
   /* Grid size and perspective transform */
   int grid_size;
-  float c[QUIRC_PERSPECTIVE_PARAMS];
+  quirc_coord_t c[QUIRC_PERSPECTIVE_PARAMS];
 } __attribute__((aligned(8)));
 
 struct quirc
@@ -85,8 +209,92 @@ struct quirc
   int w;
   int h;
 
+  /* Grey levels read by quirc_end(): either q->image or a buffer bound
+   * by quirc_begin_external(), whose rows are source_stride bytes apart.
+   */
+  const uint8_t *source;
+  int source_stride;
+
+  /* Size given to quirc_resize(). While a region is set (see
+   * quirc_set_region) w and h are the region's size, its top left
+   * corner is at (region_x, region_y) and q->pixels holds just the
+   * region, w pixels per row.
+   */
+  int image_w;
+  int image_h;
+  int region_x;
+  int region_y;
+
+  /* Binarisation method and the scratch space used by the box
+   * filter: one running sum per column and a ring of the original
+   * rows which have already been overwritten in place.
+   */
+  quirc_threshold_method_t threshold_method;
+  uint32_t *threshold_sums;
+  uint8_t *threshold_rows;
+
+  /* 1-bpp binarised image (see quirc_set_bit_plane). Pixel (x, y) is
+   * dark if bit 31 - x % 32 of bits[y * bit_stride + x / 32] is set.
+   * Each row is binarised into bit_row and then packed. Both buffers are
+   * allocated on first use; use_bits is cleared for an image if that
+   * fails.
+   */
+  int bit_plane;
+  int use_bits;
+  uint32_t *bits;
+  int bit_stride;
+  quirc_pixel_t *bit_row;
+
+  /* Interleave thresholding and finder scan (see quirc_set_fused_scan) */
+  int fused_scan;
+  int num_finder_hits;
+  struct quirc_finder_hit finder_hits[QUIRC_MAX_FINDER_HITS];
+
+  /* Work stack of the span flood fill, sized by quirc_resize() and
+   * doubled whenever a fill needs more. flood_fill_peak is the deepest
+   * it has been since then.
+   */
+  xylf_t *flood_fill_stack;
+  size_t flood_fill_size;
+  size_t flood_fill_peak;
+
+  /* Regions are numbered from QUIRC_PIXEL_REGION. regions points to
+   * region_table, or to run_regions when the run-based labeller has
+   * labelled the current image (label_runs is set).
+   */
   int num_regions;
-  struct quirc_region regions[QUIRC_MAX_REGIONS];
+  struct quirc_region *regions;
+  struct quirc_region region_table[QUIRC_MAX_REGIONS];
+
+  /* Dark runs of each row, recorded as it is thresholded. row_runs[y]
+   * is the index of the first run on row y, for h + 1 rows. rle is
+   * cleared if the run array could not be grown, in which case the
+   * finder scan reads the pixels instead.
+   */
+  int rle;
+  int32_t *row_runs;
+  struct quirc_run *runs;
+  int num_runs;
+  int max_runs;
+
+  /* Run-based labelling (see quirc_set_labelling). The run and region
+   * arrays are doubled whenever an image needs more.
+   */
+  quirc_labelling_t labelling;
+  int label_runs;
+  struct quirc_region *run_regions;
+  int max_run_regions;
+
+  /* Banded identification (see quirc_set_threads). The caller works
+   * band 0 on this struct. Each other band has a thread of its own and
+   * a private struct quirc, which shares the image fields and keeps its
+   * own threshold scratch, runs and finder hits.
+   */
+  int num_bands;
+  struct quirc_band bands[QUIRC_MAX_THREADS];
+
+  /* How grid transforms are refined (see quirc_set_refinement) */
+  quirc_refinement_t refinement;
 
   int num_capstones;
   struct quirc_capstone capstones[QUIRC_MAX_CAPSTONES];
@@ -95,6 +303,64 @@ struct quirc
   struct quirc_grid grids[QUIRC_MAX_GRIDS];
 } __attribute__((aligned(8)));
 
+/************************************************************************
+ * Stage profiling hooks
+ *
+ * When QUIRC_PROFILE is defined, quirc_end() brackets each of its
+ * stages with calls to quirc_profile_begin()/quirc_profile_end(), which
+ * must be supplied by the application (see host/qrbench.c). Otherwise
+ * the hooks compile to nothing.
+ */
+
+enum quirc_stage
+{
+  QUIRC_STAGE_PIXELS_SETUP,
+  QUIRC_STAGE_THRESHOLD,
+  QUIRC_STAGE_LABEL,
+  QUIRC_STAGE_FINDER_SCAN,
+  QUIRC_STAGE_TEST_GROUPING,
+  QUIRC_NUM_STAGES
+};
+
+#ifdef QUIRC_PROFILE
+void quirc_profile_begin(enum quirc_stage stage);
+void quirc_profile_end(enum quirc_stage stage);
+#else
+#define quirc_profile_begin(stage) ((void)0)
+#define quirc_profile_end(stage) ((void)0)
+#endif
+
+/************************************************************************
+ * Worker threads (quirc_thread.c)
+ *
+ * A worker runs one job at a time: quirc_thread_run() hands it over and
+ * returns at once, quirc_thread_wait() blocks until it has finished.
+ * index spreads the workers over the available cores.
+ */
+
+typedef void (*quirc_thread_fn)(void *arg);
+
+struct quirc_thread *quirc_thread_new(int index);
+void quirc_thread_run(struct quirc_thread *t, quirc_thread_fn fn, void *arg);
+void quirc_thread_wait(struct quirc_thread *t);
+void quirc_thread_destroy(struct quirc_thread *t);
+
+/************************************************************************
+ * Checks of a grid before it is extracted (decode.c)
+ */
+
+/* Reads the cell at (x, y) of a grid: 1 if it is dark */
+typedef int (*quirc_cell_fn)(void *arg, int x, int y);
+
+/* Checks the format information of a grid of the given size, and its
+ * version information from version 7 up, reading only those cells.
+ * Fails with QUIRC_ERROR_FORMAT_ECC, as quirc_decode() would, if
+ * neither copy of the format can be corrected, and with
+ * QUIRC_ERROR_INVALID_VERSION if neither copy of the version is within
+ * correction of the version the size implies.
+ */
+quirc_decode_error_t quirc_check_info(int size, quirc_cell_fn cell, void *arg);
+
 /************************************************************************
  * QR-code version information database
  */
@@ -118,4 +384,39 @@ struct quirc_version_info
 
 extern const struct quirc_version_info quirc_version_db[QUIRC_MAX_VERSION + 1];
 
+/* Tables derived from the database (version_tables.c, written by
+ * "make tables" in host/). Every version has the layout of its blocks
+ * at each ECC level. Versions up to QUIRC_TABLE_VERSIONS also have the
+ * order in which their data cells are read, as indices into
+ * cell_bitmap, which costs about 16 bytes of flash per data codeword:
+ * 26 kB for the first ten versions. Higher versions find their data
+ * cells at run time instead. Set it to the highest version printed on
+ * the codes to be read; raising it past the versions in
+ * version_tables.c means generating that again.
+ */
+#ifndef QUIRC_TABLE_VERSIONS
+#define QUIRC_TABLE_VERSIONS 10
+#endif
+
+struct quirc_block_layout
+{
+  uint8_t blocks;      /* Small blocks, then those one data word longer */
+  uint16_t ecc_offset; /* First ECC word in the interleaved stream */
+} __attribute__((aligned(8)));
+
+struct quirc_version_tables
+{
+  struct quirc_block_layout layout[4];
+  uint16_t data_cells;
+  const uint16_t *data_order; /* NULL above QUIRC_TABLE_VERSIONS */
+} __attribute__((aligned(8)));
+
+extern const struct quirc_version_tables
+    quirc_version_tables[QUIRC_MAX_VERSION + 1];
+
+/* Sets the bits of plane, laid out like cell_bitmap, which fall on the
+ * function patterns of the given version's grid.
+ */
+void quirc_reserve_functions(int version, uint8_t *plane);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,206 @@
+/* quirc -- QR-code recognition library
+ * Copyright (C) 2010-2012 Daniel Beer <dlbeer@gmail.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Worker threads for banded identification: FreeRTOS tasks pinned to
+ * the other cores on the ESP32, POSIX threads elsewhere. Each worker
+ * waits for one job at a time; the thread handing it over collects it
+ * with quirc_thread_wait().
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "quirc_internal.h"
+#include <Arduino.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define QUIRC_THREAD_STACK 4096
+
+struct quirc_thread
+{
+  TaskHandle_t task;
+  SemaphoreHandle_t start;
+  SemaphoreHandle_t done;
+  quirc_thread_fn fn;
+  void *arg;
+};
+
+static void thread_main(void *arg)
+{
+  struct quirc_thread *t = arg;
+
+  for (;;)
+  {
+    xSemaphoreTake(t->start, portMAX_DELAY);
+    if (!t->fn)
+      break;
+
+    t->fn(t->arg);
+    xSemaphoreGive(t->done);
+  }
+
+  xSemaphoreGive(t->done);
+  vTaskDelete(NULL);
+}
+
+struct quirc_thread *quirc_thread_new(int index)
+{
+  struct quirc_thread *t = malloc(sizeof(*t));
+
+  if (!t)
+    return NULL;
+
+  memset(t, 0, sizeof(*t));
+  t->start = xSemaphoreCreateBinary();
+  t->done = xSemaphoreCreateBinary();
+
+  /* Worker n goes n cores along from the caller, at its priority */
+  if (!t->start || !t->done ||
+      xTaskCreatePinnedToCore(thread_main, "quirc", QUIRC_THREAD_STACK, t,
+                              uxTaskPriorityGet(NULL), &t->task,
+                              (xPortGetCoreID() + index) %
+                                  portNUM_PROCESSORS) != pdPASS)
+  {
+    if (t->start)
+      vSemaphoreDelete(t->start);
+    if (t->done)
+      vSemaphoreDelete(t->done);
+    free(t);
+    return NULL;
+  }
+
+  return t;
+}
+
+void quirc_thread_run(struct quirc_thread *t, quirc_thread_fn fn, void *arg)
+{
+  t->fn = fn;
+  t->arg = arg;
+  xSemaphoreGive(t->start);
+}
+
+void quirc_thread_wait(struct quirc_thread *t)
+{
+  xSemaphoreTake(t->done, portMAX_DELAY);
+}
+
+void quirc_thread_destroy(struct quirc_thread *t)
+{
+  /* An empty job makes the task exit */
+  quirc_thread_run(t, NULL, NULL);
+  quirc_thread_wait(t);
+
+  vSemaphoreDelete(t->start);
+  vSemaphoreDelete(t->done);
+  free(t);
+}
+
+#else
+#include <pthread.h>
+
+struct quirc_thread
+{
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  quirc_thread_fn fn;
+  void *arg;
+  int busy;
+  int quit;
+};
+
+static void *thread_main(void *arg)
+{
+  struct quirc_thread *t = arg;
+
+  pthread_mutex_lock(&t->lock);
+  for (;;)
+  {
+    while (!t->busy && !t->quit)
+      pthread_cond_wait(&t->cond, &t->lock);
+    if (t->quit)
+      break;
+
+    pthread_mutex_unlock(&t->lock);
+    t->fn(t->arg);
+    pthread_mutex_lock(&t->lock);
+
+    t->busy = 0;
+    pthread_cond_broadcast(&t->cond);
+  }
+  pthread_mutex_unlock(&t->lock);
+
+  return NULL;
+}
+
+struct quirc_thread *quirc_thread_new(int index)
+{
+  struct quirc_thread *t = malloc(sizeof(*t));
+
+  (void)index;
+  if (!t)
+    return NULL;
+
+  memset(t, 0, sizeof(*t));
+  pthread_mutex_init(&t->lock, NULL);
+  pthread_cond_init(&t->cond, NULL);
+
+  if (pthread_create(&t->thread, NULL, thread_main, t))
+  {
+    pthread_cond_destroy(&t->cond);
+    pthread_mutex_destroy(&t->lock);
+    free(t);
+    return NULL;
+  }
+
+  return t;
+}
+
+void quirc_thread_run(struct quirc_thread *t, quirc_thread_fn fn, void *arg)
+{
+  pthread_mutex_lock(&t->lock);
+  t->fn = fn;
+  t->arg = arg;
+  t->busy = 1;
+  pthread_cond_broadcast(&t->cond);
+  pthread_mutex_unlock(&t->lock);
+}
+
+void quirc_thread_wait(struct quirc_thread *t)
+{
+  pthread_mutex_lock(&t->lock);
+  while (t->busy)
+    pthread_cond_wait(&t->cond, &t->lock);
+  pthread_mutex_unlock(&t->lock);
+}
+
+void quirc_thread_destroy(struct quirc_thread *t)
+{
+  pthread_mutex_lock(&t->lock);
+  t->quit = 1;
+  pthread_cond_broadcast(&t->cond);
+  pthread_mutex_unlock(&t->lock);
+
+  pthread_join(t->thread, NULL);
+  pthread_cond_destroy(&t->cond);
+  pthread_mutex_destroy(&t->lock);
+  free(t);
+}
+
+#endif
@@ -14,6 +14,7 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <string.h>
 #include "quirc_internal.h"
 
 const struct quirc_version_info quirc_version_db[QUIRC_MAX_VERSION + 1] = {
@@ -182,3 +183,68 @@ const struct quirc_version_info quirc_version_db[QUIRC_MAX_VERSION + 1] = {
      .data_bytes = 3706,
      .apat = {6, 30, 58, 86, 114, 142, 170},
      .ecc = {{.bs = 75, .dw = 47, .ns = 18}, {.bs = 148, .dw = 118, .ns = 19}, {.bs = 45, .dw = 15, .ns = 20}, {.bs = 54, .dw = 24, .ns = 34}}}};
+
+static void reserve_rect(uint8_t *plane, int size,
+                         int i, int j, int h, int w)
+{
+  int y;
+
+  for (y = i; y < i + h; y++)
+  {
+    int p = y * size + j;
+    int x;
+
+    for (x = 0; x < w; x++, p++)
+      plane[p >> 3] |= 1 << (p & 7);
+  }
+}
+
+/* Marks every cell which holds no data: finders with the format
+ * information beside them, timing patterns, version information and
+ * alignment patterns.
+ */
+void quirc_reserve_functions(int version, uint8_t *plane)
+{
+  const struct quirc_version_info *ver = &quirc_version_db[version];
+  int size = version * 4 + 17;
+  int n = 0;
+  int a;
+  int b;
+
+  memset(plane, 0, (size * size + 7) >> 3);
+
+  /* Finder + format: top left, bottom left, top right */
+  reserve_rect(plane, size, 0, 0, 9, 9);
+  reserve_rect(plane, size, size - 8, 0, 8, 9);
+  reserve_rect(plane, size, 0, size - 8, 9, 8);
+
+  /* Timing patterns */
+  reserve_rect(plane, size, 6, 0, 1, size);
+  reserve_rect(plane, size, 0, 6, size, 1);
+
+  /* Version info sits adjacent to the top-right and bottom-left
+   * finders in three rows, bounded by the timing pattern.
+   */
+  if (version >= 7)
+  {
+    reserve_rect(plane, size, 0, size - 11, 6, 11);
+    reserve_rect(plane, size, size - 11, 0, 11, 6);
+  }
+
+  /* Alignment patterns sit on every pair of positions except the
+   * three taken by finders.
+   */
+  while (n < QUIRC_MAX_ALIGNMENT && ver->apat[n])
+    n++;
+
+  for (a = 0; a < n; a++)
+    for (b = 0; b < n; b++)
+    {
+      if ((!a || a == n - 1) && (!b || b == n - 1) &&
+          (!a || !b))
+        continue;
+
+      reserve_rect(plane, size, ver->apat[a] - 2, ver->apat[b] - 2,
+                   5, 5);
+    }
+}
@@ -0,0 +1,1707 @@
+/* Generated from quirc_version_db by host/gen_tables.c: run
+ * "make tables" there, with VERSIONS=n for data cell orders up
+ * to version n, rather than editing this file.
+ */
+
+#include "quirc_internal.h"
+
+#if QUIRC_TABLE_VERSIONS > 10
+#error "version_tables.c has data cell orders up to version 10 only"
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 1
+static const uint16_t data_order_1[208] = {
+    440, 439, 419, 418, 398, 397, 377, 376, 356, 355,
+    335, 334, 314, 313, 293, 292, 272, 271, 251, 250,
+    230, 229, 209, 208, 207, 206, 228, 227, 249, 248,
+    270, 269, 291, 290, 312, 311, 333, 332, 354, 353,
+    375, 374, 396, 395, 417, 416, 438, 437, 436, 435,
+    415, 414, 394, 393, 373, 372, 352, 351, 331, 330,
+    310, 309, 289, 288, 268, 267, 247, 246, 226, 225,
+    205, 204, 203, 202, 224, 223, 245, 244, 266, 265,
+    287, 286, 308, 307, 329, 328, 350, 349, 371, 370,
+    392, 391, 413, 412, 434, 433, 432, 431, 411, 410,
+    390, 389, 369, 368, 348, 347, 327, 326, 306, 305,
+    285, 284, 264, 263, 243, 242, 222, 221, 201, 200,
+    180, 179, 159, 158, 117, 116, 96, 95, 75, 74,
+    54, 53, 33, 32, 12, 11, 10, 9, 31, 30,
+    52, 51, 73, 72, 94, 93, 115, 114, 157, 156,
+    178, 177, 199, 198, 220, 219, 241, 240, 262, 261,
+    283, 282, 304, 303, 325, 324, 346, 345, 367, 366,
+    388, 387, 409, 408, 430, 429, 260, 259, 239, 238,
+    218, 217, 197, 196, 194, 193, 215, 214, 236, 235,
+    257, 256, 255, 254, 234, 233, 213, 212, 192, 191,
+    190, 189, 211, 210, 232, 231, 253, 252};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 2
+static const uint16_t data_order_2[359] = {
+    624, 623, 599, 598, 574, 573, 549, 548, 524, 523,
+    499, 498, 474, 473, 449, 448, 424, 423, 399, 398,
+    374, 373, 349, 348, 324, 323, 299, 298, 274, 273,
+    249, 248, 247, 246, 272, 271, 297, 296, 322, 321,
+    347, 346, 372, 371, 397, 396, 422, 421, 447, 446,
+    472, 471, 497, 496, 522, 521, 547, 546, 572, 571,
+    597, 596, 622, 621, 620, 619, 595, 594, 570, 569,
+    545, 544, 395, 394, 370, 369, 345, 344, 320, 319,
+    295, 294, 270, 269, 245, 244, 243, 242, 268, 267,
+    293, 292, 318, 317, 343, 342, 368, 367, 393, 392,
+    543, 542, 568, 567, 593, 592, 618, 617, 616, 615,
+    591, 590, 566, 565, 541, 540, 515, 490, 465, 440,
+    415, 391, 390, 366, 365, 341, 340, 316, 315, 291,
+    290, 266, 265, 241, 240, 216, 215, 191, 190, 141,
+    140, 116, 115, 91, 90, 66, 65, 41, 40, 16,
+    15, 14, 13, 39, 38, 64, 63, 89, 88, 114,
+    113, 139, 138, 189, 188, 214, 213, 239, 238, 264,
+    263, 289, 288, 314, 313, 339, 338, 364, 363, 389,
+    388, 414, 413, 439, 438, 464, 463, 489, 488, 514,
+    513, 539, 538, 564, 563, 589, 588, 614, 613, 612,
+    611, 587, 586, 562, 561, 537, 536, 512, 511, 487,
+    486, 462, 461, 437, 436, 412, 411, 387, 386, 362,
+    361, 337, 336, 312, 311, 287, 286, 262, 261, 237,
+    236, 212, 211, 187, 186, 137, 136, 112, 111, 87,
+    86, 62, 61, 37, 36, 12, 11, 10, 9, 35,
+    34, 60, 59, 85, 84, 110, 109, 135, 134, 185,
+    184, 210, 209, 235, 234, 260, 259, 285, 284, 310,
+    309, 335, 334, 360, 359, 385, 384, 410, 409, 435,
+    434, 460, 459, 485, 484, 510, 509, 535, 534, 560,
+    559, 585, 584, 610, 609, 408, 407, 383, 382, 358,
+    357, 333, 332, 308, 307, 283, 282, 258, 257, 233,
+    232, 230, 229, 255, 254, 280, 279, 305, 304, 330,
+    329, 355, 354, 380, 379, 405, 404, 403, 402, 378,
+    377, 353, 352, 328, 327, 303, 302, 278, 277, 253,
+    252, 228, 227, 226, 225, 251, 250, 276, 275, 301,
+    300, 326, 325, 351, 350, 376, 375, 401, 400};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 3
+static const uint16_t data_order_3[567] = {
+    840, 839, 811, 810, 782, 781, 753, 752, 724, 723,
+    695, 694, 666, 665, 637, 636, 608, 607, 579, 578,
+    550, 549, 521, 520, 492, 491, 463, 462, 434, 433,
+    405, 404, 376, 375, 347, 346, 318, 317, 289, 288,
+    287, 286, 316, 315, 345, 344, 374, 373, 403, 402,
+    432, 431, 461, 460, 490, 489, 519, 518, 548, 547,
+    577, 576, 606, 605, 635, 634, 664, 663, 693, 692,
+    722, 721, 751, 750, 780, 779, 809, 808, 838, 837,
+    836, 835, 807, 806, 778, 777, 749, 748, 575, 574,
+    546, 545, 517, 516, 488, 487, 459, 458, 430, 429,
+    401, 400, 372, 371, 343, 342, 314, 313, 285, 284,
+    283, 282, 312, 311, 341, 340, 370, 369, 399, 398,
+    428, 427, 457, 456, 486, 485, 515, 514, 544, 543,
+    573, 572, 747, 746, 776, 775, 805, 804, 834, 833,
+    832, 831, 803, 802, 774, 773, 745, 744, 715, 686,
+    657, 628, 599, 571, 570, 542, 541, 513, 512, 484,
+    483, 455, 454, 426, 425, 397, 396, 368, 367, 339,
+    338, 310, 309, 281, 280, 252, 251, 223, 222, 165,
+    164, 136, 135, 107, 106, 78, 77, 49, 48, 20,
+    19, 18, 17, 47, 46, 76, 75, 105, 104, 134,
+    133, 163, 162, 221, 220, 250, 249, 279, 278, 308,
+    307, 337, 336, 366, 365, 395, 394, 424, 423, 453,
+    452, 482, 481, 511, 510, 540, 539, 569, 568, 598,
+    597, 627, 626, 656, 655, 685, 684, 714, 713, 743,
+    742, 772, 771, 801, 800, 830, 829, 828, 827, 799,
+    798, 770, 769, 741, 740, 712, 711, 683, 682, 654,
+    653, 625, 624, 596, 595, 567, 566, 538, 537, 509,
+    508, 480, 479, 451, 450, 422, 421, 393, 392, 364,
+    363, 335, 334, 306, 305, 277, 276, 248, 247, 219,
+    218, 161, 160, 132, 131, 103, 102, 74, 73, 45,
+    44, 16, 15, 14, 13, 43, 42, 72, 71, 101,
+    100, 130, 129, 159, 158, 217, 216, 246, 245, 275,
+    274, 304, 303, 333, 332, 362, 361, 391, 390, 420,
+    419, 449, 448, 478, 477, 507, 506, 536, 535, 565,
+    564, 594, 593, 623, 622, 652, 651, 681, 680, 710,
+    709, 739, 738, 768, 767, 797, 796, 826, 825, 824,
+    823, 795, 794, 766, 765, 737, 736, 708, 707, 679,
+    678, 650, 649, 621, 620, 592, 591, 563, 562, 534,
+    533, 505, 504, 476, 475, 447, 446, 418, 417, 389,
+    388, 360, 359, 331, 330, 302, 301, 273, 272, 244,
+    243, 215, 214, 157, 156, 128, 127, 99, 98, 70,
+    69, 41, 40, 12, 11, 10, 9, 39, 38, 68,
+    67, 97, 96, 126, 125, 155, 154, 213, 212, 242,
+    241, 271, 270, 300, 299, 329, 328, 358, 357, 387,
+    386, 416, 415, 445, 444, 474, 473, 503, 502, 532,
+    531, 561, 560, 590, 589, 619, 618, 648, 647, 677,
+    676, 706, 705, 735, 734, 764, 763, 793, 792, 822,
+    821, 588, 587, 559, 558, 530, 529, 501, 500, 472,
+    471, 443, 442, 414, 413, 385, 384, 356, 355, 327,
+    326, 298, 297, 269, 268, 266, 265, 295, 294, 324,
+    323, 353, 352, 382, 381, 411, 410, 440, 439, 469,
+    468, 498, 497, 527, 526, 556, 555, 585, 584, 583,
+    582, 554, 553, 525, 524, 496, 495, 467, 466, 438,
+    437, 409, 408, 380, 379, 351, 350, 322, 321, 293,
+    292, 264, 263, 262, 261, 291, 290, 320, 319, 349,
+    348, 378, 377, 407, 406, 436, 435, 465, 464, 494,
+    493, 523, 522, 552, 551, 581, 580};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 4
+static const uint16_t data_order_4[807] = {
+    1088, 1087, 1055, 1054, 1022, 1021, 989, 988, 956, 955,
+    923, 922, 890, 889, 857, 856, 824, 823, 791, 790,
+    758, 757, 725, 724, 692, 691, 659, 658, 626, 625,
+    593, 592, 560, 559, 527, 526, 494, 493, 461, 460,
+    428, 427, 395, 394, 362, 361, 329, 328, 327, 326,
+    360, 359, 393, 392, 426, 425, 459, 458, 492, 491,
+    525, 524, 558, 557, 591, 590, 624, 623, 657, 656,
+    690, 689, 723, 722, 756, 755, 789, 788, 822, 821,
+    855, 854, 888, 887, 921, 920, 954, 953, 987, 986,
+    1020, 1019, 1053, 1052, 1086, 1085, 1084, 1083, 1051, 1050,
+    1018, 1017, 985, 984, 787, 786, 754, 753, 721, 720,
+    688, 687, 655, 654, 622, 621, 589, 588, 556, 555,
+    523, 522, 490, 489, 457, 456, 424, 423, 391, 390,
+    358, 357, 325, 324, 323, 322, 356, 355, 389, 388,
+    422, 421, 455, 454, 488, 487, 521, 520, 554, 553,
+    587, 586, 620, 619, 653, 652, 686, 685, 719, 718,
+    752, 751, 785, 784, 983, 982, 1016, 1015, 1049, 1048,
+    1082, 1081, 1080, 1079, 1047, 1046, 1014, 1013, 981, 980,
+    947, 914, 881, 848, 815, 783, 782, 750, 749, 717,
+    716, 684, 683, 651, 650, 618, 617, 585, 584, 552,
+    551, 519, 518, 486, 485, 453, 452, 420, 419, 387,
+    386, 354, 353, 321, 320, 288, 287, 255, 254, 189,
+    188, 156, 155, 123, 122, 90, 89, 57, 56, 24,
+    23, 22, 21, 55, 54, 88, 87, 121, 120, 154,
+    153, 187, 186, 253, 252, 286, 285, 319, 318, 352,
+    351, 385, 384, 418, 417, 451, 450, 484, 483, 517,
+    516, 550, 549, 583, 582, 616, 615, 649, 648, 682,
+    681, 715, 714, 748, 747, 781, 780, 814, 813, 847,
+    846, 880, 879, 913, 912, 946, 945, 979, 978, 1012,
+    1011, 1045, 1044, 1078, 1077, 1076, 1075, 1043, 1042, 1010,
+    1009, 977, 976, 944, 943, 911, 910, 878, 877, 845,
+    844, 812, 811, 779, 778, 746, 745, 713, 712, 680,
+    679, 647, 646, 614, 613, 581, 580, 548, 547, 515,
+    514, 482, 481, 449, 448, 416, 415, 383, 382, 350,
+    349, 317, 316, 284, 283, 251, 250, 185, 184, 152,
+    151, 119, 118, 86, 85, 53, 52, 20, 19, 18,
+    17, 51, 50, 84, 83, 117, 116, 150, 149, 183,
+    182, 249, 248, 282, 281, 315, 314, 348, 347, 381,
+    380, 414, 413, 447, 446, 480, 479, 513, 512, 546,
+    545, 579, 578, 612, 611, 645, 644, 678, 677, 711,
+    710, 744, 743, 777, 776, 810, 809, 843, 842, 876,
+    875, 909, 908, 942, 941, 975, 974, 1008, 1007, 1041,
+    1040, 1074, 1073, 1072, 1071, 1039, 1038, 1006, 1005, 973,
+    972, 940, 939, 907, 906, 874, 873, 841, 840, 808,
+    807, 775, 774, 742, 741, 709, 708, 676, 675, 643,
+    642, 610, 609, 577, 576, 544, 543, 511, 510, 478,
+    477, 445, 444, 412, 411, 379, 378, 346, 345, 313,
+    312, 280, 279, 247, 246, 181, 180, 148, 147, 115,
+    114, 82, 81, 49, 48, 16, 15, 14, 13, 47,
+    46, 80, 79, 113, 112, 146, 145, 179, 178, 245,
+    244, 278, 277, 311, 310, 344, 343, 377, 376, 410,
+    409, 443, 442, 476, 475, 509, 508, 542, 541, 575,
+    574, 608, 607, 641, 640, 674, 673, 707, 706, 740,
+    739, 773, 772, 806, 805, 839, 838, 872, 871, 905,
+    904, 938, 937, 971, 970, 1004, 1003, 1037, 1036, 1070,
+    1069, 1068, 1067, 1035, 1034, 1002, 1001, 969, 968, 936,
+    935, 903, 902, 870, 869, 837, 836, 804, 803, 771,
+    770, 738, 737, 705, 704, 672, 671, 639, 638, 606,
+    605, 573, 572, 540, 539, 507, 506, 474, 473, 441,
+    440, 408, 407, 375, 374, 342, 341, 309, 308, 276,
+    275, 243, 242, 177, 176, 144, 143, 111, 110, 78,
+    77, 45, 44, 12, 11, 10, 9, 43, 42, 76,
+    75, 109, 108, 142, 141, 175, 174, 241, 240, 274,
+    273, 307, 306, 340, 339, 373, 372, 406, 405, 439,
+    438, 472, 471, 505, 504, 538, 537, 571, 570, 604,
+    603, 637, 636, 670, 669, 703, 702, 736, 735, 769,
+    768, 802, 801, 835, 834, 868, 867, 901, 900, 934,
+    933, 967, 966, 1000, 999, 1033, 1032, 1066, 1065, 800,
+    799, 767, 766, 734, 733, 701, 700, 668, 667, 635,
+    634, 602, 601, 569, 568, 536, 535, 503, 502, 470,
+    469, 437, 436, 404, 403, 371, 370, 338, 337, 305,
+    304, 302, 301, 335, 334, 368, 367, 401, 400, 434,
+    433, 467, 466, 500, 499, 533, 532, 566, 565, 599,
+    598, 632, 631, 665, 664, 698, 697, 731, 730, 764,
+    763, 797, 796, 795, 794, 762, 761, 729, 728, 696,
+    695, 663, 662, 630, 629, 597, 596, 564, 563, 531,
+    530, 498, 497, 465, 464, 432, 431, 399, 398, 366,
+    365, 333, 332, 300, 299, 298, 297, 331, 330, 364,
+    363, 397, 396, 430, 429, 463, 462, 496, 495, 529,
+    528, 562, 561, 595, 594, 628, 627, 661, 660, 694,
+    693, 727, 726, 760, 759, 793, 792};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 5
+static const uint16_t data_order_5[1079] = {
+    1368, 1367, 1331, 1330, 1294, 1293, 1257, 1256, 1220, 1219,
+    1183, 1182, 1146, 1145, 1109, 1108, 1072, 1071, 1035, 1034,
+    998, 997, 961, 960, 924, 923, 887, 886, 850, 849,
+    813, 812, 776, 775, 739, 738, 702, 701, 665, 664,
+    628, 627, 591, 590, 554, 553, 517, 516, 480, 479,
+    443, 442, 406, 405, 369, 368, 367, 366, 404, 403,
+    441, 440, 478, 477, 515, 514, 552, 551, 589, 588,
+    626, 625, 663, 662, 700, 699, 737, 736, 774, 773,
+    811, 810, 848, 847, 885, 884, 922, 921, 959, 958,
+    996, 995, 1033, 1032, 1070, 1069, 1107, 1106, 1144, 1143,
+    1181, 1180, 1218, 1217, 1255, 1254, 1292, 1291, 1329, 1328,
+    1366, 1365, 1364, 1363, 1327, 1326, 1290, 1289, 1253, 1252,
+    1031, 1030, 994, 993, 957, 956, 920, 919, 883, 882,
+    846, 845, 809, 808, 772, 771, 735, 734, 698, 697,
+    661, 660, 624, 623, 587, 586, 550, 549, 513, 512,
+    476, 475, 439, 438, 402, 401, 365, 364, 363, 362,
+    400, 399, 437, 436, 474, 473, 511, 510, 548, 547,
+    585, 584, 622, 621, 659, 658, 696, 695, 733, 732,
+    770, 769, 807, 806, 844, 843, 881, 880, 918, 917,
+    955, 954, 992, 991, 1029, 1028, 1251, 1250, 1288, 1287,
+    1325, 1324, 1362, 1361, 1360, 1359, 1323, 1322, 1286, 1285,
+    1249, 1248, 1211, 1174, 1137, 1100, 1063, 1027, 1026, 990,
+    989, 953, 952, 916, 915, 879, 878, 842, 841, 805,
+    804, 768, 767, 731, 730, 694, 693, 657, 656, 620,
+    619, 583, 582, 546, 545, 509, 508, 472, 471, 435,
+    434, 398, 397, 361, 360, 324, 323, 287, 286, 213,
+    212, 176, 175, 139, 138, 102, 101, 65, 64, 28,
+    27, 26, 25, 63, 62, 100, 99, 137, 136, 174,
+    173, 211, 210, 285, 284, 322, 321, 359, 358, 396,
+    395, 433, 432, 470, 469, 507, 506, 544, 543, 581,
+    580, 618, 617, 655, 654, 692, 691, 729, 728, 766,
+    765, 803, 802, 840, 839, 877, 876, 914, 913, 951,
+    950, 988, 987, 1025, 1024, 1062, 1061, 1099, 1098, 1136,
+    1135, 1173, 1172, 1210, 1209, 1247, 1246, 1284, 1283, 1321,
+    1320, 1358, 1357, 1356, 1355, 1319, 1318, 1282, 1281, 1245,
+    1244, 1208, 1207, 1171, 1170, 1134, 1133, 1097, 1096, 1060,
+    1059, 1023, 1022, 986, 985, 949, 948, 912, 911, 875,
+    874, 838, 837, 801, 800, 764, 763, 727, 726, 690,
+    689, 653, 652, 616, 615, 579, 578, 542, 541, 505,
+    504, 468, 467, 431, 430, 394, 393, 357, 356, 320,
+    319, 283, 282, 209, 208, 172, 171, 135, 134, 98,
+    97, 61, 60, 24, 23, 22, 21, 59, 58, 96,
+    95, 133, 132, 170, 169, 207, 206, 281, 280, 318,
+    317, 355, 354, 392, 391, 429, 428, 466, 465, 503,
+    502, 540, 539, 577, 576, 614, 613, 651, 650, 688,
+    687, 725, 724, 762, 761, 799, 798, 836, 835, 873,
+    872, 910, 909, 947, 946, 984, 983, 1021, 1020, 1058,
+    1057, 1095, 1094, 1132, 1131, 1169, 1168, 1206, 1205, 1243,
+    1242, 1280, 1279, 1317, 1316, 1354, 1353, 1352, 1351, 1315,
+    1314, 1278, 1277, 1241, 1240, 1204, 1203, 1167, 1166, 1130,
+    1129, 1093, 1092, 1056, 1055, 1019, 1018, 982, 981, 945,
+    944, 908, 907, 871, 870, 834, 833, 797, 796, 760,
+    759, 723, 722, 686, 685, 649, 648, 612, 611, 575,
+    574, 538, 537, 501, 500, 464, 463, 427, 426, 390,
+    389, 353, 352, 316, 315, 279, 278, 205, 204, 168,
+    167, 131, 130, 94, 93, 57, 56, 20, 19, 18,
+    17, 55, 54, 92, 91, 129, 128, 166, 165, 203,
+    202, 277, 276, 314, 313, 351, 350, 388, 387, 425,
+    424, 462, 461, 499, 498, 536, 535, 573, 572, 610,
+    609, 647, 646, 684, 683, 721, 720, 758, 757, 795,
+    794, 832, 831, 869, 868, 906, 905, 943, 942, 980,
+    979, 1017, 1016, 1054, 1053, 1091, 1090, 1128, 1127, 1165,
+    1164, 1202, 1201, 1239, 1238, 1276, 1275, 1313, 1312, 1350,
+    1349, 1348, 1347, 1311, 1310, 1274, 1273, 1237, 1236, 1200,
+    1199, 1163, 1162, 1126, 1125, 1089, 1088, 1052, 1051, 1015,
+    1014, 978, 977, 941, 940, 904, 903, 867, 866, 830,
+    829, 793, 792, 756, 755, 719, 718, 682, 681, 645,
+    644, 608, 607, 571, 570, 534, 533, 497, 496, 460,
+    459, 423, 422, 386, 385, 349, 348, 312, 311, 275,
+    274, 201, 200, 164, 163, 127, 126, 90, 89, 53,
+    52, 16, 15, 14, 13, 51, 50, 88, 87, 125,
+    124, 162, 161, 199, 198, 273, 272, 310, 309, 347,
+    346, 384, 383, 421, 420, 458, 457, 495, 494, 532,
+    531, 569, 568, 606, 605, 643, 642, 680, 679, 717,
+    716, 754, 753, 791, 790, 828, 827, 865, 864, 902,
+    901, 939, 938, 976, 975, 1013, 1012, 1050, 1049, 1087,
+    1086, 1124, 1123, 1161, 1160, 1198, 1197, 1235, 1234, 1272,
+    1271, 1309, 1308, 1346, 1345, 1344, 1343, 1307, 1306, 1270,
+    1269, 1233, 1232, 1196, 1195, 1159, 1158, 1122, 1121, 1085,
+    1084, 1048, 1047, 1011, 1010, 974, 973, 937, 936, 900,
+    899, 863, 862, 826, 825, 789, 788, 752, 751, 715,
+    714, 678, 677, 641, 640, 604, 603, 567, 566, 530,
+    529, 493, 492, 456, 455, 419, 418, 382, 381, 345,
+    344, 308, 307, 271, 270, 197, 196, 160, 159, 123,
+    122, 86, 85, 49, 48, 12, 11, 10, 9, 47,
+    46, 84, 83, 121, 120, 158, 157, 195, 194, 269,
+    268, 306, 305, 343, 342, 380, 379, 417, 416, 454,
+    453, 491, 490, 528, 527, 565, 564, 602, 601, 639,
+    638, 676, 675, 713, 712, 750, 749, 787, 786, 824,
+    823, 861, 860, 898, 897, 935, 934, 972, 971, 1009,
+    1008, 1046, 1045, 1083, 1082, 1120, 1119, 1157, 1156, 1194,
+    1193, 1231, 1230, 1268, 1267, 1305, 1304, 1342, 1341, 1044,
+    1043, 1007, 1006, 970, 969, 933, 932, 896, 895, 859,
+    858, 822, 821, 785, 784, 748, 747, 711, 710, 674,
+    673, 637, 636, 600, 599, 563, 562, 526, 525, 489,
+    488, 452, 451, 415, 414, 378, 377, 341, 340, 338,
+    337, 375, 374, 412, 411, 449, 448, 486, 485, 523,
+    522, 560, 559, 597, 596, 634, 633, 671, 670, 708,
+    707, 745, 744, 782, 781, 819, 818, 856, 855, 893,
+    892, 930, 929, 967, 966, 1004, 1003, 1041, 1040, 1039,
+    1038, 1002, 1001, 965, 964, 928, 927, 891, 890, 854,
+    853, 817, 816, 780, 779, 743, 742, 706, 705, 669,
+    668, 632, 631, 595, 594, 558, 557, 521, 520, 484,
+    483, 447, 446, 410, 409, 373, 372, 336, 335, 334,
+    333, 371, 370, 408, 407, 445, 444, 482, 481, 519,
+    518, 556, 555, 593, 592, 630, 629, 667, 666, 704,
+    703, 741, 740, 778, 777, 815, 814, 852, 851, 889,
+    888, 926, 925, 963, 962, 1000, 999, 1037, 1036};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 6
+static const uint16_t data_order_6[1383] = {
+    1680, 1679, 1639, 1638, 1598, 1597, 1557, 1556, 1516, 1515,
+    1475, 1474, 1434, 1433, 1393, 1392, 1352, 1351, 1311, 1310,
+    1270, 1269, 1229, 1228, 1188, 1187, 1147, 1146, 1106, 1105,
+    1065, 1064, 1024, 1023, 983, 982, 942, 941, 901, 900,
+    860, 859, 819, 818, 778, 777, 737, 736, 696, 695,
+    655, 654, 614, 613, 573, 572, 532, 531, 491, 490,
+    450, 449, 409, 408, 407, 406, 448, 447, 489, 488,
+    530, 529, 571, 570, 612, 611, 653, 652, 694, 693,
+    735, 734, 776, 775, 817, 816, 858, 857, 899, 898,
+    940, 939, 981, 980, 1022, 1021, 1063, 1062, 1104, 1103,
+    1145, 1144, 1186, 1185, 1227, 1226, 1268, 1267, 1309, 1308,
+    1350, 1349, 1391, 1390, 1432, 1431, 1473, 1472, 1514, 1513,
+    1555, 1554, 1596, 1595, 1637, 1636, 1678, 1677, 1676, 1675,
+    1635, 1634, 1594, 1593, 1553, 1552, 1307, 1306, 1266, 1265,
+    1225, 1224, 1184, 1183, 1143, 1142, 1102, 1101, 1061, 1060,
+    1020, 1019, 979, 978, 938, 937, 897, 896, 856, 855,
+    815, 814, 774, 773, 733, 732, 692, 691, 651, 650,
+    610, 609, 569, 568, 528, 527, 487, 486, 446, 445,
+    405, 404, 403, 402, 444, 443, 485, 484, 526, 525,
+    567, 566, 608, 607, 649, 648, 690, 689, 731, 730,
+    772, 771, 813, 812, 854, 853, 895, 894, 936, 935,
+    977, 976, 1018, 1017, 1059, 1058, 1100, 1099, 1141, 1140,
+    1182, 1181, 1223, 1222, 1264, 1263, 1305, 1304, 1551, 1550,
+    1592, 1591, 1633, 1632, 1674, 1673, 1672, 1671, 1631, 1630,
+    1590, 1589, 1549, 1548, 1507, 1466, 1425, 1384, 1343, 1303,
+    1302, 1262, 1261, 1221, 1220, 1180, 1179, 1139, 1138, 1098,
+    1097, 1057, 1056, 1016, 1015, 975, 974, 934, 933, 893,
+    892, 852, 851, 811, 810, 770, 769, 729, 728, 688,
+    687, 647, 646, 606, 605, 565, 564, 524, 523, 483,
+    482, 442, 441, 401, 400, 360, 359, 319, 318, 237,
+    236, 196, 195, 155, 154, 114, 113, 73, 72, 32,
+    31, 30, 29, 71, 70, 112, 111, 153, 152, 194,
+    193, 235, 234, 317, 316, 358, 357, 399, 398, 440,
+    439, 481, 480, 522, 521, 563, 562, 604, 603, 645,
+    644, 686, 685, 727, 726, 768, 767, 809, 808, 850,
+    849, 891, 890, 932, 931, 973, 972, 1014, 1013, 1055,
+    1054, 1096, 1095, 1137, 1136, 1178, 1177, 1219, 1218, 1260,
+    1259, 1301, 1300, 1342, 1341, 1383, 1382, 1424, 1423, 1465,
+    1464, 1506, 1505, 1547, 1546, 1588, 1587, 1629, 1628, 1670,
+    1669, 1668, 1667, 1627, 1626, 1586, 1585, 1545, 1544, 1504,
+    1503, 1463, 1462, 1422, 1421, 1381, 1380, 1340, 1339, 1299,
+    1298, 1258, 1257, 1217, 1216, 1176, 1175, 1135, 1134, 1094,
+    1093, 1053, 1052, 1012, 1011, 971, 970, 930, 929, 889,
+    888, 848, 847, 807, 806, 766, 765, 725, 724, 684,
+    683, 643, 642, 602, 601, 561, 560, 520, 519, 479,
+    478, 438, 437, 397, 396, 356, 355, 315, 314, 233,
+    232, 192, 191, 151, 150, 110, 109, 69, 68, 28,
+    27, 26, 25, 67, 66, 108, 107, 149, 148, 190,
+    189, 231, 230, 313, 312, 354, 353, 395, 394, 436,
+    435, 477, 476, 518, 517, 559, 558, 600, 599, 641,
+    640, 682, 681, 723, 722, 764, 763, 805, 804, 846,
+    845, 887, 886, 928, 927, 969, 968, 1010, 1009, 1051,
+    1050, 1092, 1091, 1133, 1132, 1174, 1173, 1215, 1214, 1256,
+    1255, 1297, 1296, 1338, 1337, 1379, 1378, 1420, 1419, 1461,
+    1460, 1502, 1501, 1543, 1542, 1584, 1583, 1625, 1624, 1666,
+    1665, 1664, 1663, 1623, 1622, 1582, 1581, 1541, 1540, 1500,
+    1499, 1459, 1458, 1418, 1417, 1377, 1376, 1336, 1335, 1295,
+    1294, 1254, 1253, 1213, 1212, 1172, 1171, 1131, 1130, 1090,
+    1089, 1049, 1048, 1008, 1007, 967, 966, 926, 925, 885,
+    884, 844, 843, 803, 802, 762, 761, 721, 720, 680,
+    679, 639, 638, 598, 597, 557, 556, 516, 515, 475,
+    474, 434, 433, 393, 392, 352, 351, 311, 310, 229,
+    228, 188, 187, 147, 146, 106, 105, 65, 64, 24,
+    23, 22, 21, 63, 62, 104, 103, 145, 144, 186,
+    185, 227, 226, 309, 308, 350, 349, 391, 390, 432,
+    431, 473, 472, 514, 513, 555, 554, 596, 595, 637,
+    636, 678, 677, 719, 718, 760, 759, 801, 800, 842,
+    841, 883, 882, 924, 923, 965, 964, 1006, 1005, 1047,
+    1046, 1088, 1087, 1129, 1128, 1170, 1169, 1211, 1210, 1252,
+    1251, 1293, 1292, 1334, 1333, 1375, 1374, 1416, 1415, 1457,
+    1456, 1498, 1497, 1539, 1538, 1580, 1579, 1621, 1620, 1662,
+    1661, 1660, 1659, 1619, 1618, 1578, 1577, 1537, 1536, 1496,
+    1495, 1455, 1454, 1414, 1413, 1373, 1372, 1332, 1331, 1291,
+    1290, 1250, 1249, 1209, 1208, 1168, 1167, 1127, 1126, 1086,
+    1085, 1045, 1044, 1004, 1003, 963, 962, 922, 921, 881,
+    880, 840, 839, 799, 798, 758, 757, 717, 716, 676,
+    675, 635, 634, 594, 593, 553, 552, 512, 511, 471,
+    470, 430, 429, 389, 388, 348, 347, 307, 306, 225,
+    224, 184, 183, 143, 142, 102, 101, 61, 60, 20,
+    19, 18, 17, 59, 58, 100, 99, 141, 140, 182,
+    181, 223, 222, 305, 304, 346, 345, 387, 386, 428,
+    427, 469, 468, 510, 509, 551, 550, 592, 591, 633,
+    632, 674, 673, 715, 714, 756, 755, 797, 796, 838,
+    837, 879, 878, 920, 919, 961, 960, 1002, 1001, 1043,
+    1042, 1084, 1083, 1125, 1124, 1166, 1165, 1207, 1206, 1248,
+    1247, 1289, 1288, 1330, 1329, 1371, 1370, 1412, 1411, 1453,
+    1452, 1494, 1493, 1535, 1534, 1576, 1575, 1617, 1616, 1658,
+    1657, 1656, 1655, 1615, 1614, 1574, 1573, 1533, 1532, 1492,
+    1491, 1451, 1450, 1410, 1409, 1369, 1368, 1328, 1327, 1287,
+    1286, 1246, 1245, 1205, 1204, 1164, 1163, 1123, 1122, 1082,
+    1081, 1041, 1040, 1000, 999, 959, 958, 918, 917, 877,
+    876, 836, 835, 795, 794, 754, 753, 713, 712, 672,
+    671, 631, 630, 590, 589, 549, 548, 508, 507, 467,
+    466, 426, 425, 385, 384, 344, 343, 303, 302, 221,
+    220, 180, 179, 139, 138, 98, 97, 57, 56, 16,
+    15, 14, 13, 55, 54, 96, 95, 137, 136, 178,
+    177, 219, 218, 301, 300, 342, 341, 383, 382, 424,
+    423, 465, 464, 506, 505, 547, 546, 588, 587, 629,
+    628, 670, 669, 711, 710, 752, 751, 793, 792, 834,
+    833, 875, 874, 916, 915, 957, 956, 998, 997, 1039,
+    1038, 1080, 1079, 1121, 1120, 1162, 1161, 1203, 1202, 1244,
+    1243, 1285, 1284, 1326, 1325, 1367, 1366, 1408, 1407, 1449,
+    1448, 1490, 1489, 1531, 1530, 1572, 1571, 1613, 1612, 1654,
+    1653, 1652, 1651, 1611, 1610, 1570, 1569, 1529, 1528, 1488,
+    1487, 1447, 1446, 1406, 1405, 1365, 1364, 1324, 1323, 1283,
+    1282, 1242, 1241, 1201, 1200, 1160, 1159, 1119, 1118, 1078,
+    1077, 1037, 1036, 996, 995, 955, 954, 914, 913, 873,
+    872, 832, 831, 791, 790, 750, 749, 709, 708, 668,
+    667, 627, 626, 586, 585, 545, 544, 504, 503, 463,
+    462, 422, 421, 381, 380, 340, 339, 299, 298, 217,
+    216, 176, 175, 135, 134, 94, 93, 53, 52, 12,
+    11, 10, 9, 51, 50, 92, 91, 133, 132, 174,
+    173, 215, 214, 297, 296, 338, 337, 379, 378, 420,
+    419, 461, 460, 502, 501, 543, 542, 584, 583, 625,
+    624, 666, 665, 707, 706, 748, 747, 789, 788, 830,
+    829, 871, 870, 912, 911, 953, 952, 994, 993, 1035,
+    1034, 1076, 1075, 1117, 1116, 1158, 1157, 1199, 1198, 1240,
+    1239, 1281, 1280, 1322, 1321, 1363, 1362, 1404, 1403, 1445,
+    1444, 1486, 1485, 1527, 1526, 1568, 1567, 1609, 1608, 1650,
+    1649, 1320, 1319, 1279, 1278, 1238, 1237, 1197, 1196, 1156,
+    1155, 1115, 1114, 1074, 1073, 1033, 1032, 992, 991, 951,
+    950, 910, 909, 869, 868, 828, 827, 787, 786, 746,
+    745, 705, 704, 664, 663, 623, 622, 582, 581, 541,
+    540, 500, 499, 459, 458, 418, 417, 377, 376, 374,
+    373, 415, 414, 456, 455, 497, 496, 538, 537, 579,
+    578, 620, 619, 661, 660, 702, 701, 743, 742, 784,
+    783, 825, 824, 866, 865, 907, 906, 948, 947, 989,
+    988, 1030, 1029, 1071, 1070, 1112, 1111, 1153, 1152, 1194,
+    1193, 1235, 1234, 1276, 1275, 1317, 1316, 1315, 1314, 1274,
+    1273, 1233, 1232, 1192, 1191, 1151, 1150, 1110, 1109, 1069,
+    1068, 1028, 1027, 987, 986, 946, 945, 905, 904, 864,
+    863, 823, 822, 782, 781, 741, 740, 700, 699, 659,
+    658, 618, 617, 577, 576, 536, 535, 495, 494, 454,
+    453, 413, 412, 372, 371, 370, 369, 411, 410, 452,
+    451, 493, 492, 534, 533, 575, 574, 616, 615, 657,
+    656, 698, 697, 739, 738, 780, 779, 821, 820, 862,
+    861, 903, 902, 944, 943, 985, 984, 1026, 1025, 1067,
+    1066, 1108, 1107, 1149, 1148, 1190, 1189, 1231, 1230, 1272,
+    1271, 1313, 1312};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 7
+static const uint16_t data_order_7[1568] = {
+    2024, 2023, 1979, 1978, 1934, 1933, 1889, 1888, 1844, 1843,
+    1799, 1798, 1754, 1753, 1709, 1708, 1664, 1663, 1619, 1618,
+    1574, 1573, 1529, 1528, 1484, 1483, 1439, 1438, 1394, 1393,
+    1349, 1348, 1304, 1303, 1259, 1258, 1214, 1213, 1169, 1168,
+    1124, 1123, 1079, 1078, 1034, 1033, 989, 988, 944, 943,
+    899, 898, 854, 853, 809, 808, 764, 763, 719, 718,
+    674, 673, 629, 628, 584, 583, 539, 538, 494, 493,
+    449, 448, 447, 446, 492, 491, 537, 536, 582, 581,
+    627, 626, 672, 671, 717, 716, 762, 761, 807, 806,
+    852, 851, 897, 896, 942, 941, 987, 986, 1032, 1031,
+    1077, 1076, 1122, 1121, 1167, 1166, 1212, 1211, 1257, 1256,
+    1302, 1301, 1347, 1346, 1392, 1391, 1437, 1436, 1482, 1481,
+    1527, 1526, 1572, 1571, 1617, 1616, 1662, 1661, 1707, 1706,
+    1752, 1751, 1797, 1796, 1842, 1841, 1887, 1886, 1932, 1931,
+    1977, 1976, 2022, 2021, 2020, 2019, 1975, 1974, 1930, 1929,
+    1885, 1884, 1615, 1614, 1570, 1569, 1525, 1524, 1480, 1479,
+    1435, 1434, 1390, 1389, 1345, 1344, 1300, 1299, 1255, 1254,
+    1210, 1209, 1165, 1164, 895, 894, 850, 849, 805, 804,
+    760, 759, 715, 714, 670, 669, 625, 624, 580, 579,
+    535, 534, 490, 489, 445, 444, 443, 442, 488, 487,
+    533, 532, 578, 577, 623, 622, 668, 667, 713, 712,
+    758, 757, 803, 802, 848, 847, 893, 892, 1163, 1162,
+    1208, 1207, 1253, 1252, 1298, 1297, 1343, 1342, 1388, 1387,
+    1433, 1432, 1478, 1477, 1523, 1522, 1568, 1567, 1613, 1612,
+    1883, 1882, 1928, 1927, 1973, 1972, 2018, 2017, 2016, 2015,
+    1971, 1970, 1926, 1925, 1881, 1880, 1835, 1790, 1745, 1700,
+    1655, 1611, 1610, 1566, 1565, 1521, 1520, 1476, 1475, 1431,
+    1430, 1386, 1385, 1341, 1340, 1296, 1295, 1251, 1250, 1206,
+    1205, 1161, 1160, 1115, 1070, 1025, 980, 935, 891, 890,
+    846, 845, 801, 800, 756, 755, 711, 710, 666, 665,
+    621, 620, 576, 575, 531, 530, 486, 485, 441, 440,
+    396, 395, 351, 350, 33, 78, 123, 168, 213, 258,
+    349, 348, 394, 393, 439, 438, 484, 483, 529, 528,
+    574, 573, 619, 618, 664, 663, 709, 708, 754, 753,
+    799, 798, 844, 843, 889, 888, 934, 933, 979, 978,
+    1024, 1023, 1069, 1068, 1114, 1113, 1159, 1158, 1204, 1203,
+    1249, 1248, 1294, 1293, 1339, 1338, 1384, 1383, 1429, 1428,
+    1474, 1473, 1519, 1518, 1564, 1563, 1609, 1608, 1654, 1653,
+    1699, 1698, 1744, 1743, 1789, 1788, 1834, 1833, 1879, 1878,
+    1924, 1923, 1969, 1968, 2014, 2013, 2012, 2011, 1967, 1966,
+    1922, 1921, 1877, 1876, 1832, 1831, 1787, 1786, 1742, 1741,
+    1697, 1696, 1652, 1651, 1607, 1606, 1562, 1561, 1517, 1516,
+    1472, 1471, 1427, 1426, 1382, 1381, 1337, 1336, 1292, 1291,
+    1247, 1246, 1202, 1201, 1157, 1156, 1112, 1111, 1067, 1066,
+    1022, 1021, 977, 976, 932, 931, 887, 886, 842, 841,
+    797, 796, 752, 751, 707, 706, 662, 661, 617, 616,
+    572, 571, 527, 526, 482, 481, 437, 436, 392, 391,
+    347, 346, 257, 256, 212, 211, 167, 166, 122, 121,
+    77, 76, 32, 31, 30, 29, 75, 74, 120, 119,
+    165, 164, 210, 209, 255, 254, 345, 344, 390, 389,
+    435, 434, 480, 479, 525, 524, 570, 569, 615, 614,
+    660, 659, 705, 704, 750, 749, 795, 794, 840, 839,
+    885, 884, 930, 929, 975, 974, 1020, 1019, 1065, 1064,
+    1110, 1109, 1155, 1154, 1200, 1199, 1245, 1244, 1290, 1289,
+    1335, 1334, 1380, 1379, 1425, 1424, 1470, 1469, 1515, 1514,
+    1560, 1559, 1605, 1604, 1650, 1649, 1695, 1694, 1740, 1739,
+    1785, 1784, 1830, 1829, 1875, 1874, 1920, 1919, 1965, 1964,
+    2010, 2009, 2008, 2007, 1963, 1962, 1918, 1917, 1873, 1872,
+    1828, 1827, 1783, 1782, 1738, 1737, 1693, 1692, 1648, 1647,
+    1603, 1602, 1558, 1557, 1513, 1512, 1468, 1467, 1423, 1422,
+    1378, 1377, 1333, 1332, 1288, 1287, 1243, 1242, 1198, 1197,
+    1153, 1152, 1108, 1107, 1063, 1062, 1018, 1017, 973, 972,
+    928, 927, 883, 882, 838, 837, 793, 792, 748, 747,
+    703, 702, 658, 657, 613, 612, 568, 567, 523, 522,
+    478, 477, 433, 432, 388, 387, 343, 342, 253, 252,
+    208, 207, 163, 162, 118, 117, 73, 72, 28, 27,
+    26, 25, 71, 70, 116, 115, 161, 160, 206, 205,
+    251, 250, 341, 340, 386, 385, 431, 430, 476, 475,
+    521, 520, 566, 565, 611, 610, 656, 655, 701, 700,
+    746, 745, 791, 790, 836, 835, 881, 880, 926, 925,
+    971, 970, 1016, 1015, 1061, 1060, 1106, 1105, 1151, 1150,
+    1196, 1195, 1241, 1240, 1286, 1285, 1331, 1330, 1376, 1375,
+    1421, 1420, 1466, 1465, 1511, 1510, 1556, 1555, 1601, 1600,
+    1646, 1645, 1691, 1690, 1736, 1735, 1781, 1780, 1826, 1825,
+    1871, 1870, 1916, 1915, 1961, 1960, 2006, 2005, 2004, 2003,
+    1959, 1958, 1914, 1913, 1869, 1868, 1599, 1598, 1554, 1553,
+    1509, 1508, 1464, 1463, 1419, 1418, 1374, 1373, 1329, 1328,
+    1284, 1283, 1239, 1238, 1194, 1193, 1149, 1148, 879, 878,
+    834, 833, 789, 788, 744, 743, 699, 698, 654, 653,
+    609, 608, 564, 563, 519, 518, 474, 473, 429, 428,
+    159, 158, 114, 113, 69, 68, 24, 23, 22, 21,
+    67, 66, 112, 111, 157, 156, 427, 426, 472, 471,
+    517, 516, 562, 561, 607, 606, 652, 651, 697, 696,
+    742, 741, 787, 786, 832, 831, 877, 876, 1147, 1146,
+    1192, 1191, 1237, 1236, 1282, 1281, 1327, 1326, 1372, 1371,
+    1417, 1416, 1462, 1461, 1507, 1506, 1552, 1551, 1597, 1596,
+    1867, 1866, 1912, 1911, 1957, 1956, 2002, 2001, 2000, 1999,
+    1955, 1954, 1910, 1909, 1865, 1864, 1819, 1774, 1729, 1684,
+    1639, 1595, 1594, 1550, 1549, 1505, 1504, 1460, 1459, 1415,
+    1414, 1370, 1369, 1325, 1324, 1280, 1279, 1235, 1234, 1190,
+    1189, 1145, 1144, 1099, 1054, 1009, 964, 919, 875, 874,
+    830, 829, 785, 784, 740, 739, 695, 694, 650, 649,
+    605, 604, 560, 559, 515, 514, 470, 469, 425, 424,
+    379, 334, 244, 199, 155, 154, 110, 109, 65, 64,
+    20, 19, 18, 17, 63, 62, 108, 107, 153, 152,
+    198, 197, 243, 242, 333, 332, 378, 377, 423, 422,
+    468, 467, 513, 512, 558, 557, 603, 602, 648, 647,
+    693, 692, 738, 737, 783, 782, 828, 827, 873, 872,
+    918, 917, 963, 962, 1008, 1007, 1053, 1052, 1098, 1097,
+    1143, 1142, 1188, 1187, 1233, 1232, 1278, 1277, 1323, 1322,
+    1368, 1367, 1413, 1412, 1458, 1457, 1503, 1502, 1548, 1547,
+    1593, 1592, 1638, 1637, 1683, 1682, 1728, 1727, 1773, 1772,
+    1818, 1817, 1863, 1862, 1908, 1907, 1953, 1952, 1998, 1997,
+    1996, 1995, 1951, 1950, 1906, 1905, 1861, 1860, 1816, 1815,
+    1771, 1770, 1726, 1725, 1681, 1680, 1636, 1635, 1591, 1590,
+    1546, 1545, 1501, 1500, 1456, 1455, 1411, 1410, 1366, 1365,
+    1321, 1320, 1276, 1275, 1231, 1230, 1186, 1185, 1141, 1140,
+    1096, 1095, 1051, 1050, 1006, 1005, 961, 960, 916, 915,
+    871, 870, 826, 825, 781, 780, 736, 735, 691, 690,
+    646, 645, 601, 600, 556, 555, 511, 510, 466, 465,
+    421, 420, 376, 375, 331, 330, 241, 240, 196, 195,
+    151, 150, 106, 105, 61, 60, 16, 15, 14, 13,
+    59, 58, 104, 103, 149, 148, 194, 193, 239, 238,
+    329, 328, 374, 373, 419, 418, 464, 463, 509, 508,
+    554, 553, 599, 598, 644, 643, 689, 688, 734, 733,
+    779, 778, 824, 823, 869, 868, 914, 913, 959, 958,
+    1004, 1003, 1049, 1048, 1094, 1093, 1139, 1138, 1184, 1183,
+    1229, 1228, 1274, 1273, 1319, 1318, 1364, 1363, 1409, 1408,
+    1454, 1453, 1499, 1498, 1544, 1543, 1589, 1588, 1634, 1633,
+    1679, 1678, 1724, 1723, 1769, 1768, 1814, 1813, 1859, 1858,
+    1904, 1903, 1949, 1948, 1994, 1993, 1992, 1991, 1947, 1946,
+    1902, 1901, 1857, 1856, 1812, 1811, 1767, 1766, 1722, 1721,
+    1677, 1676, 1632, 1631, 1587, 1586, 1542, 1541, 1497, 1496,
+    1452, 1451, 1407, 1406, 1362, 1361, 1317, 1316, 1272, 1271,
+    1227, 1226, 1182, 1181, 1137, 1136, 1092, 1091, 1047, 1046,
+    1002, 1001, 957, 956, 912, 911, 867, 866, 822, 821,
+    777, 776, 732, 731, 687, 686, 642, 641, 597, 596,
+    552, 551, 507, 506, 462, 461, 417, 416, 372, 371,
+    327, 326, 237, 236, 192, 191, 147, 146, 102, 101,
+    57, 56, 12, 11, 10, 9, 55, 54, 100, 99,
+    145, 144, 190, 189, 235, 234, 325, 324, 370, 369,
+    415, 414, 460, 459, 505, 504, 550, 549, 595, 594,
+    640, 639, 685, 684, 730, 729, 775, 774, 820, 819,
+    865, 864, 910, 909, 955, 954, 1000, 999, 1045, 1044,
+    1090, 1089, 1135, 1134, 1180, 1179, 1225, 1224, 1270, 1269,
+    1315, 1314, 1360, 1359, 1405, 1404, 1450, 1449, 1495, 1494,
+    1540, 1539, 1585, 1584, 1630, 1629, 1675, 1674, 1720, 1719,
+    1765, 1764, 1810, 1809, 1855, 1854, 1900, 1899, 1945, 1944,
+    1990, 1989, 1628, 1627, 1583, 1582, 1538, 1537, 1493, 1492,
+    1448, 1447, 1403, 1402, 1358, 1357, 1313, 1312, 1268, 1267,
+    1223, 1222, 1178, 1177, 1133, 1132, 863, 862, 818, 817,
+    773, 772, 728, 727, 683, 682, 638, 637, 593, 592,
+    548, 547, 503, 502, 458, 457, 413, 412, 410, 409,
+    455, 454, 500, 499, 545, 544, 590, 589, 635, 634,
+    680, 679, 725, 724, 770, 769, 815, 814, 860, 859,
+    1130, 1129, 1175, 1174, 1220, 1219, 1265, 1264, 1310, 1309,
+    1355, 1354, 1400, 1399, 1445, 1444, 1490, 1489, 1488, 1487,
+    1443, 1442, 1398, 1397, 1353, 1352, 1308, 1307, 1263, 1262,
+    1218, 1217, 1173, 1172, 1128, 1127, 1083, 1082, 1038, 1037,
+    993, 992, 948, 947, 903, 902, 858, 857, 813, 812,
+    768, 767, 723, 722, 678, 677, 633, 632, 588, 587,
+    543, 542, 498, 497, 453, 452, 408, 407, 406, 405,
+    451, 450, 496, 495, 541, 540, 586, 585, 631, 630,
+    676, 675, 721, 720, 766, 765, 811, 810, 856, 855,
+    901, 900, 946, 945, 991, 990, 1036, 1035, 1081, 1080,
+    1126, 1125, 1171, 1170, 1216, 1215, 1261, 1260, 1306, 1305,
+    1351, 1350, 1396, 1395, 1441, 1440, 1486, 1485};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 8
+static const uint16_t data_order_8[1936] = {
+    2400, 2399, 2351, 2350, 2302, 2301, 2253, 2252, 2204, 2203,
+    2155, 2154, 2106, 2105, 2057, 2056, 2008, 2007, 1959, 1958,
+    1910, 1909, 1861, 1860, 1812, 1811, 1763, 1762, 1714, 1713,
+    1665, 1664, 1616, 1615, 1567, 1566, 1518, 1517, 1469, 1468,
+    1420, 1419, 1371, 1370, 1322, 1321, 1273, 1272, 1224, 1223,
+    1175, 1174, 1126, 1125, 1077, 1076, 1028, 1027, 979, 978,
+    930, 929, 881, 880, 832, 831, 783, 782, 734, 733,
+    685, 684, 636, 635, 587, 586, 538, 537, 489, 488,
+    487, 486, 536, 535, 585, 584, 634, 633, 683, 682,
+    732, 731, 781, 780, 830, 829, 879, 878, 928, 927,
+    977, 976, 1026, 1025, 1075, 1074, 1124, 1123, 1173, 1172,
+    1222, 1221, 1271, 1270, 1320, 1319, 1369, 1368, 1418, 1417,
+    1467, 1466, 1516, 1515, 1565, 1564, 1614, 1613, 1663, 1662,
+    1712, 1711, 1761, 1760, 1810, 1809, 1859, 1858, 1908, 1907,
+    1957, 1956, 2006, 2005, 2055, 2054, 2104, 2103, 2153, 2152,
+    2202, 2201, 2251, 2250, 2300, 2299, 2349, 2348, 2398, 2397,
+    2396, 2395, 2347, 2346, 2298, 2297, 2249, 2248, 1955, 1954,
+    1906, 1905, 1857, 1856, 1808, 1807, 1759, 1758, 1710, 1709,
+    1661, 1660, 1612, 1611, 1563, 1562, 1514, 1513, 1465, 1464,
+    1416, 1415, 1367, 1366, 1073, 1072, 1024, 1023, 975, 974,
+    926, 925, 877, 876, 828, 827, 779, 778, 730, 729,
+    681, 680, 632, 631, 583, 582, 534, 533, 485, 484,
+    483, 482, 532, 531, 581, 580, 630, 629, 679, 678,
+    728, 727, 777, 776, 826, 825, 875, 874, 924, 923,
+    973, 972, 1022, 1021, 1071, 1070, 1365, 1364, 1414, 1413,
+    1463, 1462, 1512, 1511, 1561, 1560, 1610, 1609, 1659, 1658,
+    1708, 1707, 1757, 1756, 1806, 1805, 1855, 1854, 1904, 1903,
+    1953, 1952, 2247, 2246, 2296, 2295, 2345, 2344, 2394, 2393,
+    2392, 2391, 2343, 2342, 2294, 2293, 2245, 2244, 2195, 2146,
+    2097, 2048, 1999, 1951, 1950, 1902, 1901, 1853, 1852, 1804,
+    1803, 1755, 1754, 1706, 1705, 1657, 1656, 1608, 1607, 1559,
+    1558, 1510, 1509, 1461, 1460, 1412, 1411, 1363, 1362, 1313,
+    1264, 1215, 1166, 1117, 1069, 1068, 1020, 1019, 971, 970,
+    922, 921, 873, 872, 824, 823, 775, 774, 726, 725,
+    677, 676, 628, 627, 579, 578, 530, 529, 481, 480,
+    432, 431, 383, 382, 37, 86, 135, 184, 233, 282,
+    381, 380, 430, 429, 479, 478, 528, 527, 577, 576,
+    626, 625, 675, 674, 724, 723, 773, 772, 822, 821,
+    871, 870, 920, 919, 969, 968, 1018, 1017, 1067, 1066,
+    1116, 1115, 1165, 1164, 1214, 1213, 1263, 1262, 1312, 1311,
+    1361, 1360, 1410, 1409, 1459, 1458, 1508, 1507, 1557, 1556,
+    1606, 1605, 1655, 1654, 1704, 1703, 1753, 1752, 1802, 1801,
+    1851, 1850, 1900, 1899, 1949, 1948, 1998, 1997, 2047, 2046,
+    2096, 2095, 2145, 2144, 2194, 2193, 2243, 2242, 2292, 2291,
+    2341, 2340, 2390, 2389, 2388, 2387, 2339, 2338, 2290, 2289,
+    2241, 2240, 2192, 2191, 2143, 2142, 2094, 2093, 2045, 2044,
+    1996, 1995, 1947, 1946, 1898, 1897, 1849, 1848, 1800, 1799,
+    1751, 1750, 1702, 1701, 1653, 1652, 1604, 1603, 1555, 1554,
+    1506, 1505, 1457, 1456, 1408, 1407, 1359, 1358, 1310, 1309,
+    1261, 1260, 1212, 1211, 1163, 1162, 1114, 1113, 1065, 1064,
+    1016, 1015, 967, 966, 918, 917, 869, 868, 820, 819,
+    771, 770, 722, 721, 673, 672, 624, 623, 575, 574,
+    526, 525, 477, 476, 428, 427, 379, 378, 281, 280,
+    232, 231, 183, 182, 134, 133, 85, 84, 36, 35,
+    34, 33, 83, 82, 132, 131, 181, 180, 230, 229,
+    279, 278, 377, 376, 426, 425, 475, 474, 524, 523,
+    573, 572, 622, 621, 671, 670, 720, 719, 769, 768,
+    818, 817, 867, 866, 916, 915, 965, 964, 1014, 1013,
+    1063, 1062, 1112, 1111, 1161, 1160, 1210, 1209, 1259, 1258,
+    1308, 1307, 1357, 1356, 1406, 1405, 1455, 1454, 1504, 1503,
+    1553, 1552, 1602, 1601, 1651, 1650, 1700, 1699, 1749, 1748,
+    1798, 1797, 1847, 1846, 1896, 1895, 1945, 1944, 1994, 1993,
+    2043, 2042, 2092, 2091, 2141, 2140, 2190, 2189, 2239, 2238,
+    2288, 2287, 2337, 2336, 2386, 2385, 2384, 2383, 2335, 2334,
+    2286, 2285, 2237, 2236, 2188, 2187, 2139, 2138, 2090, 2089,
+    2041, 2040, 1992, 1991, 1943, 1942, 1894, 1893, 1845, 1844,
+    1796, 1795, 1747, 1746, 1698, 1697, 1649, 1648, 1600, 1599,
+    1551, 1550, 1502, 1501, 1453, 1452, 1404, 1403, 1355, 1354,
+    1306, 1305, 1257, 1256, 1208, 1207, 1159, 1158, 1110, 1109,
+    1061, 1060, 1012, 1011, 963, 962, 914, 913, 865, 864,
+    816, 815, 767, 766, 718, 717, 669, 668, 620, 619,
+    571, 570, 522, 521, 473, 472, 424, 423, 375, 374,
+    277, 276, 228, 227, 179, 178, 130, 129, 81, 80,
+    32, 31, 30, 29, 79, 78, 128, 127, 177, 176,
+    226, 225, 275, 274, 373, 372, 422, 421, 471, 470,
+    520, 519, 569, 568, 618, 617, 667, 666, 716, 715,
+    765, 764, 814, 813, 863, 862, 912, 911, 961, 960,
+    1010, 1009, 1059, 1058, 1108, 1107, 1157, 1156, 1206, 1205,
+    1255, 1254, 1304, 1303, 1353, 1352, 1402, 1401, 1451, 1450,
+    1500, 1499, 1549, 1548, 1598, 1597, 1647, 1646, 1696, 1695,
+    1745, 1744, 1794, 1793, 1843, 1842, 1892, 1891, 1941, 1940,
+    1990, 1989, 2039, 2038, 2088, 2087, 2137, 2136, 2186, 2185,
+    2235, 2234, 2284, 2283, 2333, 2332, 2382, 2381, 2380, 2379,
+    2331, 2330, 2282, 2281, 2233, 2232, 2184, 2183, 2135, 2134,
+    2086, 2085, 2037, 2036, 1988, 1987, 1939, 1938, 1890, 1889,
+    1841, 1840, 1792, 1791, 1743, 1742, 1694, 1693, 1645, 1644,
+    1596, 1595, 1547, 1546, 1498, 1497, 1449, 1448, 1400, 1399,
+    1351, 1350, 1302, 1301, 1253, 1252, 1204, 1203, 1155, 1154,
+    1106, 1105, 1057, 1056, 1008, 1007, 959, 958, 910, 909,
+    861, 860, 812, 811, 763, 762, 714, 713, 665, 664,
+    616, 615, 567, 566, 518, 517, 469, 468, 420, 419,
+    371, 370, 273, 272, 224, 223, 175, 174, 126, 125,
+    77, 76, 28, 27, 26, 25, 75, 74, 124, 123,
+    173, 172, 467, 466, 516, 515, 565, 564, 614, 613,
+    663, 662, 712, 711, 761, 760, 810, 809, 859, 858,
+    908, 907, 957, 956, 1006, 1005, 1055, 1054, 1349, 1348,
+    1398, 1397, 1447, 1446, 1496, 1495, 1545, 1544, 1594, 1593,
+    1643, 1642, 1692, 1691, 1741, 1740, 1790, 1789, 1839, 1838,
+    1888, 1887, 1937, 1936, 2231, 2230, 2280, 2279, 2329, 2328,
+    2378, 2377, 2376, 2375, 2327, 2326, 2278, 2277, 2229, 2228,
+    1935, 1934, 1886, 1885, 1837, 1836, 1788, 1787, 1739, 1738,
+    1690, 1689, 1641, 1640, 1592, 1591, 1543, 1542, 1494, 1493,
+    1445, 1444, 1396, 1395, 1347, 1346, 1053, 1052, 1004, 1003,
+    955, 954, 906, 905, 857, 856, 808, 807, 759, 758,
+    710, 709, 661, 660, 612, 611, 563, 562, 514, 513,
+    465, 464, 171, 170, 122, 121, 73, 72, 24, 23,
+    22, 21, 71, 70, 120, 119, 169, 168, 217, 266,
+    364, 413, 463, 462, 512, 511, 561, 560, 610, 609,
+    659, 658, 708, 707, 757, 756, 806, 805, 855, 854,
+    904, 903, 953, 952, 1002, 1001, 1051, 1050, 1099, 1148,
+    1197, 1246, 1295, 1345, 1344, 1394, 1393, 1443, 1442, 1492,
+    1491, 1541, 1540, 1590, 1589, 1639, 1638, 1688, 1687, 1737,
+    1736, 1786, 1785, 1835, 1834, 1884, 1883, 1933, 1932, 1981,
+    2030, 2079, 2128, 2177, 2227, 2226, 2276, 2275, 2325, 2324,
+    2374, 2373, 2372, 2371, 2323, 2322, 2274, 2273, 2225, 2224,
+    2176, 2175, 2127, 2126, 2078, 2077, 2029, 2028, 1980, 1979,
+    1931, 1930, 1882, 1881, 1833, 1832, 1784, 1783, 1735, 1734,
+    1686, 1685, 1637, 1636, 1588, 1587, 1539, 1538, 1490, 1489,
+    1441, 1440, 1392, 1391, 1343, 1342, 1294, 1293, 1245, 1244,
+    1196, 1195, 1147, 1146, 1098, 1097, 1049, 1048, 1000, 999,
+    951, 950, 902, 901, 853, 852, 804, 803, 755, 754,
+    706, 705, 657, 656, 608, 607, 559, 558, 510, 509,
+    461, 460, 412, 411, 363, 362, 265, 264, 216, 215,
+    167, 166, 118, 117, 69, 68, 20, 19, 18, 17,
+    67, 66, 116, 115, 165, 164, 214, 213, 263, 262,
+    361, 360, 410, 409, 459, 458, 508, 507, 557, 556,
+    606, 605, 655, 654, 704, 703, 753, 752, 802, 801,
+    851, 850, 900, 899, 949, 948, 998, 997, 1047, 1046,
+    1096, 1095, 1145, 1144, 1194, 1193, 1243, 1242, 1292, 1291,
+    1341, 1340, 1390, 1389, 1439, 1438, 1488, 1487, 1537, 1536,
+    1586, 1585, 1635, 1634, 1684, 1683, 1733, 1732, 1782, 1781,
+    1831, 1830, 1880, 1879, 1929, 1928, 1978, 1977, 2027, 2026,
+    2076, 2075, 2125, 2124, 2174, 2173, 2223, 2222, 2272, 2271,
+    2321, 2320, 2370, 2369, 2368, 2367, 2319, 2318, 2270, 2269,
+    2221, 2220, 2172, 2171, 2123, 2122, 2074, 2073, 2025, 2024,
+    1976, 1975, 1927, 1926, 1878, 1877, 1829, 1828, 1780, 1779,
+    1731, 1730, 1682, 1681, 1633, 1632, 1584, 1583, 1535, 1534,
+    1486, 1485, 1437, 1436, 1388, 1387, 1339, 1338, 1290, 1289,
+    1241, 1240, 1192, 1191, 1143, 1142, 1094, 1093, 1045, 1044,
+    996, 995, 947, 946, 898, 897, 849, 848, 800, 799,
+    751, 750, 702, 701, 653, 652, 604, 603, 555, 554,
+    506, 505, 457, 456, 408, 407, 359, 358, 261, 260,
+    212, 211, 163, 162, 114, 113, 65, 64, 16, 15,
+    14, 13, 63, 62, 112, 111, 161, 160, 210, 209,
+    259, 258, 357, 356, 406, 405, 455, 454, 504, 503,
+    553, 552, 602, 601, 651, 650, 700, 699, 749, 748,
+    798, 797, 847, 846, 896, 895, 945, 944, 994, 993,
+    1043, 1042, 1092, 1091, 1141, 1140, 1190, 1189, 1239, 1238,
+    1288, 1287, 1337, 1336, 1386, 1385, 1435, 1434, 1484, 1483,
+    1533, 1532, 1582, 1581, 1631, 1630, 1680, 1679, 1729, 1728,
+    1778, 1777, 1827, 1826, 1876, 1875, 1925, 1924, 1974, 1973,
+    2023, 2022, 2072, 2071, 2121, 2120, 2170, 2169, 2219, 2218,
+    2268, 2267, 2317, 2316, 2366, 2365, 2364, 2363, 2315, 2314,
+    2266, 2265, 2217, 2216, 2168, 2167, 2119, 2118, 2070, 2069,
+    2021, 2020, 1972, 1971, 1923, 1922, 1874, 1873, 1825, 1824,
+    1776, 1775, 1727, 1726, 1678, 1677, 1629, 1628, 1580, 1579,
+    1531, 1530, 1482, 1481, 1433, 1432, 1384, 1383, 1335, 1334,
+    1286, 1285, 1237, 1236, 1188, 1187, 1139, 1138, 1090, 1089,
+    1041, 1040, 992, 991, 943, 942, 894, 893, 845, 844,
+    796, 795, 747, 746, 698, 697, 649, 648, 600, 599,
+    551, 550, 502, 501, 453, 452, 404, 403, 355, 354,
+    257, 256, 208, 207, 159, 158, 110, 109, 61, 60,
+    12, 11, 10, 9, 59, 58, 108, 107, 157, 156,
+    206, 205, 255, 254, 353, 352, 402, 401, 451, 450,
+    500, 499, 549, 548, 598, 597, 647, 646, 696, 695,
+    745, 744, 794, 793, 843, 842, 892, 891, 941, 940,
+    990, 989, 1039, 1038, 1088, 1087, 1137, 1136, 1186, 1185,
+    1235, 1234, 1284, 1283, 1333, 1332, 1382, 1381, 1431, 1430,
+    1480, 1479, 1529, 1528, 1578, 1577, 1627, 1626, 1676, 1675,
+    1725, 1724, 1774, 1773, 1823, 1822, 1872, 1871, 1921, 1920,
+    1970, 1969, 2019, 2018, 2068, 2067, 2117, 2116, 2166, 2165,
+    2215, 2214, 2264, 2263, 2313, 2312, 2362, 2361, 1968, 1967,
+    1919, 1918, 1870, 1869, 1821, 1820, 1772, 1771, 1723, 1722,
+    1674, 1673, 1625, 1624, 1576, 1575, 1527, 1526, 1478, 1477,
+    1429, 1428, 1380, 1379, 1331, 1330, 1037, 1036, 988, 987,
+    939, 938, 890, 889, 841, 840, 792, 791, 743, 742,
+    694, 693, 645, 644, 596, 595, 547, 546, 498, 497,
+    449, 448, 446, 445, 495, 494, 544, 543, 593, 592,
+    642, 641, 691, 690, 740, 739, 789, 788, 838, 837,
+    887, 886, 936, 935, 985, 984, 1034, 1033, 1328, 1327,
+    1377, 1376, 1426, 1425, 1475, 1474, 1524, 1523, 1573, 1572,
+    1622, 1621, 1671, 1670, 1720, 1719, 1769, 1768, 1818, 1817,
+    1816, 1815, 1767, 1766, 1718, 1717, 1669, 1668, 1620, 1619,
+    1571, 1570, 1522, 1521, 1473, 1472, 1424, 1423, 1375, 1374,
+    1326, 1325, 1277, 1276, 1228, 1227, 1179, 1178, 1130, 1129,
+    1081, 1080, 1032, 1031, 983, 982, 934, 933, 885, 884,
+    836, 835, 787, 786, 738, 737, 689, 688, 640, 639,
+    591, 590, 542, 541, 493, 492, 444, 443, 442, 441,
+    491, 490, 540, 539, 589, 588, 638, 637, 687, 686,
+    736, 735, 785, 784, 834, 833, 883, 882, 932, 931,
+    981, 980, 1030, 1029, 1079, 1078, 1128, 1127, 1177, 1176,
+    1226, 1225, 1275, 1274, 1324, 1323, 1373, 1372, 1422, 1421,
+    1471, 1470, 1520, 1519, 1569, 1568, 1618, 1617, 1667, 1666,
+    1716, 1715, 1765, 1764, 1814, 1813};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 9
+static const uint16_t data_order_9[2336] = {
+    2808, 2807, 2755, 2754, 2702, 2701, 2649, 2648, 2596, 2595,
+    2543, 2542, 2490, 2489, 2437, 2436, 2384, 2383, 2331, 2330,
+    2278, 2277, 2225, 2224, 2172, 2171, 2119, 2118, 2066, 2065,
+    2013, 2012, 1960, 1959, 1907, 1906, 1854, 1853, 1801, 1800,
+    1748, 1747, 1695, 1694, 1642, 1641, 1589, 1588, 1536, 1535,
+    1483, 1482, 1430, 1429, 1377, 1376, 1324, 1323, 1271, 1270,
+    1218, 1217, 1165, 1164, 1112, 1111, 1059, 1058, 1006, 1005,
+    953, 952, 900, 899, 847, 846, 794, 793, 741, 740,
+    688, 687, 635, 634, 582, 581, 529, 528, 527, 526,
+    580, 579, 633, 632, 686, 685, 739, 738, 792, 791,
+    845, 844, 898, 897, 951, 950, 1004, 1003, 1057, 1056,
+    1110, 1109, 1163, 1162, 1216, 1215, 1269, 1268, 1322, 1321,
+    1375, 1374, 1428, 1427, 1481, 1480, 1534, 1533, 1587, 1586,
+    1640, 1639, 1693, 1692, 1746, 1745, 1799, 1798, 1852, 1851,
+    1905, 1904, 1958, 1957, 2011, 2010, 2064, 2063, 2117, 2116,
+    2170, 2169, 2223, 2222, 2276, 2275, 2329, 2328, 2382, 2381,
+    2435, 2434, 2488, 2487, 2541, 2540, 2594, 2593, 2647, 2646,
+    2700, 2699, 2753, 2752, 2806, 2805, 2804, 2803, 2751, 2750,
+    2698, 2697, 2645, 2644, 2327, 2326, 2274, 2273, 2221, 2220,
+    2168, 2167, 2115, 2114, 2062, 2061, 2009, 2008, 1956, 1955,
+    1903, 1902, 1850, 1849, 1797, 1796, 1744, 1743, 1691, 1690,
+    1638, 1637, 1585, 1584, 1267, 1266, 1214, 1213, 1161, 1160,
+    1108, 1107, 1055, 1054, 1002, 1001, 949, 948, 896, 895,
+    843, 842, 790, 789, 737, 736, 684, 683, 631, 630,
+    578, 577, 525, 524, 523, 522, 576, 575, 629, 628,
+    682, 681, 735, 734, 788, 787, 841, 840, 894, 893,
+    947, 946, 1000, 999, 1053, 1052, 1106, 1105, 1159, 1158,
+    1212, 1211, 1265, 1264, 1583, 1582, 1636, 1635, 1689, 1688,
+    1742, 1741, 1795, 1794, 1848, 1847, 1901, 1900, 1954, 1953,
+    2007, 2006, 2060, 2059, 2113, 2112, 2166, 2165, 2219, 2218,
+    2272, 2271, 2325, 2324, 2643, 2642, 2696, 2695, 2749, 2748,
+    2802, 2801, 2800, 2799, 2747, 2746, 2694, 2693, 2641, 2640,
+    2587, 2534, 2481, 2428, 2375, 2323, 2322, 2270, 2269, 2217,
+    2216, 2164, 2163, 2111, 2110, 2058, 2057, 2005, 2004, 1952,
+    1951, 1899, 1898, 1846, 1845, 1793, 1792, 1740, 1739, 1687,
+    1686, 1634, 1633, 1581, 1580, 1527, 1474, 1421, 1368, 1315,
+    1263, 1262, 1210, 1209, 1157, 1156, 1104, 1103, 1051, 1050,
+    998, 997, 945, 944, 892, 891, 839, 838, 786, 785,
+    733, 732, 680, 679, 627, 626, 574, 573, 521, 520,
+    468, 467, 415, 414, 41, 94, 147, 200, 253, 306,
+    413, 412, 466, 465, 519, 518, 572, 571, 625, 624,
+    678, 677, 731, 730, 784, 783, 837, 836, 890, 889,
+    943, 942, 996, 995, 1049, 1048, 1102, 1101, 1155, 1154,
+    1208, 1207, 1261, 1260, 1314, 1313, 1367, 1366, 1420, 1419,
+    1473, 1472, 1526, 1525, 1579, 1578, 1632, 1631, 1685, 1684,
+    1738, 1737, 1791, 1790, 1844, 1843, 1897, 1896, 1950, 1949,
+    2003, 2002, 2056, 2055, 2109, 2108, 2162, 2161, 2215, 2214,
+    2268, 2267, 2321, 2320, 2374, 2373, 2427, 2426, 2480, 2479,
+    2533, 2532, 2586, 2585, 2639, 2638, 2692, 2691, 2745, 2744,
+    2798, 2797, 2796, 2795, 2743, 2742, 2690, 2689, 2637, 2636,
+    2584, 2583, 2531, 2530, 2478, 2477, 2425, 2424, 2372, 2371,
+    2319, 2318, 2266, 2265, 2213, 2212, 2160, 2159, 2107, 2106,
+    2054, 2053, 2001, 2000, 1948, 1947, 1895, 1894, 1842, 1841,
+    1789, 1788, 1736, 1735, 1683, 1682, 1630, 1629, 1577, 1576,
+    1524, 1523, 1471, 1470, 1418, 1417, 1365, 1364, 1312, 1311,
+    1259, 1258, 1206, 1205, 1153, 1152, 1100, 1099, 1047, 1046,
+    994, 993, 941, 940, 888, 887, 835, 834, 782, 781,
+    729, 728, 676, 675, 623, 622, 570, 569, 517, 516,
+    464, 463, 411, 410, 305, 304, 252, 251, 199, 198,
+    146, 145, 93, 92, 40, 39, 38, 37, 91, 90,
+    144, 143, 197, 196, 250, 249, 303, 302, 409, 408,
+    462, 461, 515, 514, 568, 567, 621, 620, 674, 673,
+    727, 726, 780, 779, 833, 832, 886, 885, 939, 938,
+    992, 991, 1045, 1044, 1098, 1097, 1151, 1150, 1204, 1203,
+    1257, 1256, 1310, 1309, 1363, 1362, 1416, 1415, 1469, 1468,
+    1522, 1521, 1575, 1574, 1628, 1627, 1681, 1680, 1734, 1733,
+    1787, 1786, 1840, 1839, 1893, 1892, 1946, 1945, 1999, 1998,
+    2052, 2051, 2105, 2104, 2158, 2157, 2211, 2210, 2264, 2263,
+    2317, 2316, 2370, 2369, 2423, 2422, 2476, 2475, 2529, 2528,
+    2582, 2581, 2635, 2634, 2688, 2687, 2741, 2740, 2794, 2793,
+    2792, 2791, 2739, 2738, 2686, 2685, 2633, 2632, 2580, 2579,
+    2527, 2526, 2474, 2473, 2421, 2420, 2368, 2367, 2315, 2314,
+    2262, 2261, 2209, 2208, 2156, 2155, 2103, 2102, 2050, 2049,
+    1997, 1996, 1944, 1943, 1891, 1890, 1838, 1837, 1785, 1784,
+    1732, 1731, 1679, 1678, 1626, 1625, 1573, 1572, 1520, 1519,
+    1467, 1466, 1414, 1413, 1361, 1360, 1308, 1307, 1255, 1254,
+    1202, 1201, 1149, 1148, 1096, 1095, 1043, 1042, 990, 989,
+    937, 936, 884, 883, 831, 830, 778, 777, 725, 724,
+    672, 671, 619, 618, 566, 565, 513, 512, 460, 459,
+    407, 406, 301, 300, 248, 247, 195, 194, 142, 141,
+    89, 88, 36, 35, 34, 33, 87, 86, 140, 139,
+    193, 192, 246, 245, 299, 298, 405, 404, 458, 457,
+    511, 510, 564, 563, 617, 616, 670, 669, 723, 722,
+    776, 775, 829, 828, 882, 881, 935, 934, 988, 987,
+    1041, 1040, 1094, 1093, 1147, 1146, 1200, 1199, 1253, 1252,
+    1306, 1305, 1359, 1358, 1412, 1411, 1465, 1464, 1518, 1517,
+    1571, 1570, 1624, 1623, 1677, 1676, 1730, 1729, 1783, 1782,
+    1836, 1835, 1889, 1888, 1942, 1941, 1995, 1994, 2048, 2047,
+    2101, 2100, 2154, 2153, 2207, 2206, 2260, 2259, 2313, 2312,
+    2366, 2365, 2419, 2418, 2472, 2471, 2525, 2524, 2578, 2577,
+    2631, 2630, 2684, 2683, 2737, 2736, 2790, 2789, 2788, 2787,
+    2735, 2734, 2682, 2681, 2629, 2628, 2576, 2575, 2523, 2522,
+    2470, 2469, 2417, 2416, 2364, 2363, 2311, 2310, 2258, 2257,
+    2205, 2204, 2152, 2151, 2099, 2098, 2046, 2045, 1993, 1992,
+    1940, 1939, 1887, 1886, 1834, 1833, 1781, 1780, 1728, 1727,
+    1675, 1674, 1622, 1621, 1569, 1568, 1516, 1515, 1463, 1462,
+    1410, 1409, 1357, 1356, 1304, 1303, 1251, 1250, 1198, 1197,
+    1145, 1144, 1092, 1091, 1039, 1038, 986, 985, 933, 932,
+    880, 879, 827, 826, 774, 773, 721, 720, 668, 667,
+    615, 614, 562, 561, 509, 508, 456, 455, 403, 402,
+    297, 296, 244, 243, 191, 190, 138, 137, 85, 84,
+    32, 31, 30, 29, 83, 82, 136, 135, 189, 188,
+    242, 241, 295, 294, 401, 400, 454, 453, 507, 506,
+    560, 559, 613, 612, 666, 665, 719, 718, 772, 771,
+    825, 824, 878, 877, 931, 930, 984, 983, 1037, 1036,
+    1090, 1089, 1143, 1142, 1196, 1195, 1249, 1248, 1302, 1301,
+    1355, 1354, 1408, 1407, 1461, 1460, 1514, 1513, 1567, 1566,
+    1620, 1619, 1673, 1672, 1726, 1725, 1779, 1778, 1832, 1831,
+    1885, 1884, 1938, 1937, 1991, 1990, 2044, 2043, 2097, 2096,
+    2150, 2149, 2203, 2202, 2256, 2255, 2309, 2308, 2362, 2361,
+    2415, 2414, 2468, 2467, 2521, 2520, 2574, 2573, 2627, 2626,
+    2680, 2679, 2733, 2732, 2786, 2785, 2784, 2783, 2731, 2730,
+    2678, 2677, 2625, 2624, 2307, 2306, 2254, 2253, 2201, 2200,
+    2148, 2147, 2095, 2094, 2042, 2041, 1989, 1988, 1936, 1935,
+    1883, 1882, 1830, 1829, 1777, 1776, 1724, 1723, 1671, 1670,
+    1618, 1617, 1565, 1564, 1247, 1246, 1194, 1193, 1141, 1140,
+    1088, 1087, 1035, 1034, 982, 981, 929, 928, 876, 875,
+    823, 822, 770, 769, 717, 716, 664, 663, 611, 610,
+    558, 557, 505, 504, 187, 186, 134, 133, 81, 80,
+    28, 27, 26, 25, 79, 78, 132, 131, 185, 184,
+    503, 502, 556, 555, 609, 608, 662, 661, 715, 714,
+    768, 767, 821, 820, 874, 873, 927, 926, 980, 979,
+    1033, 1032, 1086, 1085, 1139, 1138, 1192, 1191, 1245, 1244,
+    1563, 1562, 1616, 1615, 1669, 1668, 1722, 1721, 1775, 1774,
+    1828, 1827, 1881, 1880, 1934, 1933, 1987, 1986, 2040, 2039,
+    2093, 2092, 2146, 2145, 2199, 2198, 2252, 2251, 2305, 2304,
+    2623, 2622, 2676, 2675, 2729, 2728, 2782, 2781, 2780, 2779,
+    2727, 2726, 2674, 2673, 2621, 2620, 2567, 2514, 2461, 2408,
+    2355, 2303, 2302, 2250, 2249, 2197, 2196, 2144, 2143, 2091,
+    2090, 2038, 2037, 1985, 1984, 1932, 1931, 1879, 1878, 1826,
+    1825, 1773, 1772, 1720, 1719, 1667, 1666, 1614, 1613, 1561,
+    1560, 1507, 1454, 1401, 1348, 1295, 1243, 1242, 1190, 1189,
+    1137, 1136, 1084, 1083, 1031, 1030, 978, 977, 925, 924,
+    872, 871, 819, 818, 766, 765, 713, 712, 660, 659,
+    607, 606, 554, 553, 501, 500, 447, 394, 288, 235,
+    183, 182, 130, 129, 77, 76, 24, 23, 22, 21,
+    75, 74, 128, 127, 181, 180, 234, 233, 287, 286,
+    393, 392, 446, 445, 499, 498, 552, 551, 605, 604,
+    658, 657, 711, 710, 764, 763, 817, 816, 870, 869,
+    923, 922, 976, 975, 1029, 1028, 1082, 1081, 1135, 1134,
+    1188, 1187, 1241, 1240, 1294, 1293, 1347, 1346, 1400, 1399,
+    1453, 1452, 1506, 1505, 1559, 1558, 1612, 1611, 1665, 1664,
+    1718, 1717, 1771, 1770, 1824, 1823, 1877, 1876, 1930, 1929,
+    1983, 1982, 2036, 2035, 2089, 2088, 2142, 2141, 2195, 2194,
+    2248, 2247, 2301, 2300, 2354, 2353, 2407, 2406, 2460, 2459,
+    2513, 2512, 2566, 2565, 2619, 2618, 2672, 2671, 2725, 2724,
+    2778, 2777, 2776, 2775, 2723, 2722, 2670, 2669, 2617, 2616,
+    2564, 2563, 2511, 2510, 2458, 2457, 2405, 2404, 2352, 2351,
+    2299, 2298, 2246, 2245, 2193, 2192, 2140, 2139, 2087, 2086,
+    2034, 2033, 1981, 1980, 1928, 1927, 1875, 1874, 1822, 1821,
+    1769, 1768, 1716, 1715, 1663, 1662, 1610, 1609, 1557, 1556,
+    1504, 1503, 1451, 1450, 1398, 1397, 1345, 1344, 1292, 1291,
+    1239, 1238, 1186, 1185, 1133, 1132, 1080, 1079, 1027, 1026,
+    974, 973, 921, 920, 868, 867, 815, 814, 762, 761,
+    709, 708, 656, 655, 603, 602, 550, 549, 497, 496,
+    444, 443, 391, 390, 285, 284, 232, 231, 179, 178,
+    126, 125, 73, 72, 20, 19, 18, 17, 71, 70,
+    124, 123, 177, 176, 230, 229, 283, 282, 389, 388,
+    442, 441, 495, 494, 548, 547, 601, 600, 654, 653,
+    707, 706, 760, 759, 813, 812, 866, 865, 919, 918,
+    972, 971, 1025, 1024, 1078, 1077, 1131, 1130, 1184, 1183,
+    1237, 1236, 1290, 1289, 1343, 1342, 1396, 1395, 1449, 1448,
+    1502, 1501, 1555, 1554, 1608, 1607, 1661, 1660, 1714, 1713,
+    1767, 1766, 1820, 1819, 1873, 1872, 1926, 1925, 1979, 1978,
+    2032, 2031, 2085, 2084, 2138, 2137, 2191, 2190, 2244, 2243,
+    2297, 2296, 2350, 2349, 2403, 2402, 2456, 2455, 2509, 2508,
+    2562, 2561, 2615, 2614, 2668, 2667, 2721, 2720, 2774, 2773,
+    2772, 2771, 2719, 2718, 2666, 2665, 2613, 2612, 2560, 2559,
+    2507, 2506, 2454, 2453, 2401, 2400, 2348, 2347, 2295, 2294,
+    2242, 2241, 2189, 2188, 2136, 2135, 2083, 2082, 2030, 2029,
+    1977, 1976, 1924, 1923, 1871, 1870, 1818, 1817, 1765, 1764,
+    1712, 1711, 1659, 1658, 1606, 1605, 1553, 1552, 1500, 1499,
+    1447, 1446, 1394, 1393, 1341, 1340, 1288, 1287, 1235, 1234,
+    1182, 1181, 1129, 1128, 1076, 1075, 1023, 1022, 970, 969,
+    917, 916, 864, 863, 811, 810, 758, 757, 705, 704,
+    652, 651, 599, 598, 546, 545, 493, 492, 440, 439,
+    387, 386, 281, 280, 228, 227, 175, 174, 122, 121,
+    69, 68, 16, 15, 14, 13, 67, 66, 120, 119,
+    173, 172, 226, 225, 279, 278, 385, 384, 438, 437,
+    491, 490, 544, 543, 597, 596, 650, 649, 703, 702,
+    756, 755, 809, 808, 862, 861, 915, 914, 968, 967,
+    1021, 1020, 1074, 1073, 1127, 1126, 1180, 1179, 1233, 1232,
+    1286, 1285, 1339, 1338, 1392, 1391, 1445, 1444, 1498, 1497,
+    1551, 1550, 1604, 1603, 1657, 1656, 1710, 1709, 1763, 1762,
+    1816, 1815, 1869, 1868, 1922, 1921, 1975, 1974, 2028, 2027,
+    2081, 2080, 2134, 2133, 2187, 2186, 2240, 2239, 2293, 2292,
+    2346, 2345, 2399, 2398, 2452, 2451, 2505, 2504, 2558, 2557,
+    2611, 2610, 2664, 2663, 2717, 2716, 2770, 2769, 2768, 2767,
+    2715, 2714, 2662, 2661, 2609, 2608, 2556, 2555, 2503, 2502,
+    2450, 2449, 2397, 2396, 2344, 2343, 2291, 2290, 2238, 2237,
+    2185, 2184, 2132, 2131, 2079, 2078, 2026, 2025, 1973, 1972,
+    1920, 1919, 1867, 1866, 1814, 1813, 1761, 1760, 1708, 1707,
+    1655, 1654, 1602, 1601, 1549, 1548, 1496, 1495, 1443, 1442,
+    1390, 1389, 1337, 1336, 1284, 1283, 1231, 1230, 1178, 1177,
+    1125, 1124, 1072, 1071, 1019, 1018, 966, 965, 913, 912,
+    860, 859, 807, 806, 754, 753, 701, 700, 648, 647,
+    595, 594, 542, 541, 489, 488, 436, 435, 383, 382,
+    277, 276, 224, 223, 171, 170, 118, 117, 65, 64,
+    12, 11, 10, 9, 63, 62, 116, 115, 169, 168,
+    222, 221, 275, 274, 381, 380, 434, 433, 487, 486,
+    540, 539, 593, 592, 646, 645, 699, 698, 752, 751,
+    805, 804, 858, 857, 911, 910, 964, 963, 1017, 1016,
+    1070, 1069, 1123, 1122, 1176, 1175, 1229, 1228, 1282, 1281,
+    1335, 1334, 1388, 1387, 1441, 1440, 1494, 1493, 1547, 1546,
+    1600, 1599, 1653, 1652, 1706, 1705, 1759, 1758, 1812, 1811,
+    1865, 1864, 1918, 1917, 1971, 1970, 2024, 2023, 2077, 2076,
+    2130, 2129, 2183, 2182, 2236, 2235, 2289, 2288, 2342, 2341,
+    2395, 2394, 2448, 2447, 2501, 2500, 2554, 2553, 2607, 2606,
+    2660, 2659, 2713, 2712, 2766, 2765, 2340, 2339, 2287, 2286,
+    2234, 2233, 2181, 2180, 2128, 2127, 2075, 2074, 2022, 2021,
+    1969, 1968, 1916, 1915, 1863, 1862, 1810, 1809, 1757, 1756,
+    1704, 1703, 1651, 1650, 1598, 1597, 1545, 1544, 1227, 1226,
+    1174, 1173, 1121, 1120, 1068, 1067, 1015, 1014, 962, 961,
+    909, 908, 856, 855, 803, 802, 750, 749, 697, 696,
+    644, 643, 591, 590, 538, 537, 485, 484, 482, 481,
+    535, 534, 588, 587, 641, 640, 694, 693, 747, 746,
+    800, 799, 853, 852, 906, 905, 959, 958, 1012, 1011,
+    1065, 1064, 1118, 1117, 1171, 1170, 1224, 1223, 1542, 1541,
+    1595, 1594, 1648, 1647, 1701, 1700, 1754, 1753, 1807, 1806,
+    1860, 1859, 1913, 1912, 1966, 1965, 2019, 2018, 2072, 2071,
+    2125, 2124, 2178, 2177, 2176, 2175, 2123, 2122, 2070, 2069,
+    2017, 2016, 1964, 1963, 1911, 1910, 1858, 1857, 1805, 1804,
+    1752, 1751, 1699, 1698, 1646, 1645, 1593, 1592, 1540, 1539,
+    1487, 1486, 1434, 1433, 1381, 1380, 1328, 1327, 1275, 1274,
+    1222, 1221, 1169, 1168, 1116, 1115, 1063, 1062, 1010, 1009,
+    957, 956, 904, 903, 851, 850, 798, 797, 745, 744,
+    692, 691, 639, 638, 586, 585, 533, 532, 480, 479,
+    478, 477, 531, 530, 584, 583, 637, 636, 690, 689,
+    743, 742, 796, 795, 849, 848, 902, 901, 955, 954,
+    1008, 1007, 1061, 1060, 1114, 1113, 1167, 1166, 1220, 1219,
+    1273, 1272, 1326, 1325, 1379, 1378, 1432, 1431, 1485, 1484,
+    1538, 1537, 1591, 1590, 1644, 1643, 1697, 1696, 1750, 1749,
+    1803, 1802, 1856, 1855, 1909, 1908, 1962, 1961, 2015, 2014,
+    2068, 2067, 2121, 2120, 2174, 2173};
+#endif
+
+#if QUIRC_TABLE_VERSIONS >= 10
+static const uint16_t data_order_10[2768] = {
+    3248, 3247, 3191, 3190, 3134, 3133, 3077, 3076, 3020, 3019,
+    2963, 2962, 2906, 2905, 2849, 2848, 2792, 2791, 2735, 2734,
+    2678, 2677, 2621, 2620, 2564, 2563, 2507, 2506, 2450, 2449,
+    2393, 2392, 2336, 2335, 2279, 2278, 2222, 2221, 2165, 2164,
+    2108, 2107, 2051, 2050, 1994, 1993, 1937, 1936, 1880, 1879,
+    1823, 1822, 1766, 1765, 1709, 1708, 1652, 1651, 1595, 1594,
+    1538, 1537, 1481, 1480, 1424, 1423, 1367, 1366, 1310, 1309,
+    1253, 1252, 1196, 1195, 1139, 1138, 1082, 1081, 1025, 1024,
+    968, 967, 911, 910, 854, 853, 797, 796, 740, 739,
+    683, 682, 626, 625, 569, 568, 567, 566, 624, 623,
+    681, 680, 738, 737, 795, 794, 852, 851, 909, 908,
+    966, 965, 1023, 1022, 1080, 1079, 1137, 1136, 1194, 1193,
+    1251, 1250, 1308, 1307, 1365, 1364, 1422, 1421, 1479, 1478,
+    1536, 1535, 1593, 1592, 1650, 1649, 1707, 1706, 1764, 1763,
+    1821, 1820, 1878, 1877, 1935, 1934, 1992, 1991, 2049, 2048,
+    2106, 2105, 2163, 2162, 2220, 2219, 2277, 2276, 2334, 2333,
+    2391, 2390, 2448, 2447, 2505, 2504, 2562, 2561, 2619, 2618,
+    2676, 2675, 2733, 2732, 2790, 2789, 2847, 2846, 2904, 2903,
+    2961, 2960, 3018, 3017, 3075, 3074, 3132, 3131, 3189, 3188,
+    3246, 3245, 3244, 3243, 3187, 3186, 3130, 3129, 3073, 3072,
+    2731, 2730, 2674, 2673, 2617, 2616, 2560, 2559, 2503, 2502,
+    2446, 2445, 2389, 2388, 2332, 2331, 2275, 2274, 2218, 2217,
+    2161, 2160, 2104, 2103, 2047, 2046, 1990, 1989, 1933, 1932,
+    1876, 1875, 1819, 1818, 1477, 1476, 1420, 1419, 1363, 1362,
+    1306, 1305, 1249, 1248, 1192, 1191, 1135, 1134, 1078, 1077,
+    1021, 1020, 964, 963, 907, 906, 850, 849, 793, 792,
+    736, 735, 679, 678, 622, 621, 565, 564, 563, 562,
+    620, 619, 677, 676, 734, 733, 791, 790, 848, 847,
+    905, 904, 962, 961, 1019, 1018, 1076, 1075, 1133, 1132,
+    1190, 1189, 1247, 1246, 1304, 1303, 1361, 1360, 1418, 1417,
+    1475, 1474, 1817, 1816, 1874, 1873, 1931, 1930, 1988, 1987,
+    2045, 2044, 2102, 2101, 2159, 2158, 2216, 2215, 2273, 2272,
+    2330, 2329, 2387, 2386, 2444, 2443, 2501, 2500, 2558, 2557,
+    2615, 2614, 2672, 2671, 2729, 2728, 3071, 3070, 3128, 3127,
+    3185, 3184, 3242, 3241, 3240, 3239, 3183, 3182, 3126, 3125,
+    3069, 3068, 3011, 2954, 2897, 2840, 2783, 2727, 2726, 2670,
+    2669, 2613, 2612, 2556, 2555, 2499, 2498, 2442, 2441, 2385,
+    2384, 2328, 2327, 2271, 2270, 2214, 2213, 2157, 2156, 2100,
+    2099, 2043, 2042, 1986, 1985, 1929, 1928, 1872, 1871, 1815,
+    1814, 1757, 1700, 1643, 1586, 1529, 1473, 1472, 1416, 1415,
+    1359, 1358, 1302, 1301, 1245, 1244, 1188, 1187, 1131, 1130,
+    1074, 1073, 1017, 1016, 960, 959, 903, 902, 846, 845,
+    789, 788, 732, 731, 675, 674, 618, 617, 561, 560,
+    504, 503, 447, 446, 45, 102, 159, 216, 273, 330,
+    445, 444, 502, 501, 559, 558, 616, 615, 673, 672,
+    730, 729, 787, 786, 844, 843, 901, 900, 958, 957,
+    1015, 1014, 1072, 1071, 1129, 1128, 1186, 1185, 1243, 1242,
+    1300, 1299, 1357, 1356, 1414, 1413, 1471, 1470, 1528, 1527,
+    1585, 1584, 1642, 1641, 1699, 1698, 1756, 1755, 1813, 1812,
+    1870, 1869, 1927, 1926, 1984, 1983, 2041, 2040, 2098, 2097,
+    2155, 2154, 2212, 2211, 2269, 2268, 2326, 2325, 2383, 2382,
+    2440, 2439, 2497, 2496, 2554, 2553, 2611, 2610, 2668, 2667,
+    2725, 2724, 2782, 2781, 2839, 2838, 2896, 2895, 2953, 2952,
+    3010, 3009, 3067, 3066, 3124, 3123, 3181, 3180, 3238, 3237,
+    3236, 3235, 3179, 3178, 3122, 3121, 3065, 3064, 3008, 3007,
+    2951, 2950, 2894, 2893, 2837, 2836, 2780, 2779, 2723, 2722,
+    2666, 2665, 2609, 2608, 2552, 2551, 2495, 2494, 2438, 2437,
+    2381, 2380, 2324, 2323, 2267, 2266, 2210, 2209, 2153, 2152,
+    2096, 2095, 2039, 2038, 1982, 1981, 1925, 1924, 1868, 1867,
+    1811, 1810, 1754, 1753, 1697, 1696, 1640, 1639, 1583, 1582,
+    1526, 1525, 1469, 1468, 1412, 1411, 1355, 1354, 1298, 1297,
+    1241, 1240, 1184, 1183, 1127, 1126, 1070, 1069, 1013, 1012,
+    956, 955, 899, 898, 842, 841, 785, 784, 728, 727,
+    671, 670, 614, 613, 557, 556, 500, 499, 443, 442,
+    329, 328, 272, 271, 215, 214, 158, 157, 101, 100,
+    44, 43, 42, 41, 99, 98, 156, 155, 213, 212,
+    270, 269, 327, 326, 441, 440, 498, 497, 555, 554,
+    612, 611, 669, 668, 726, 725, 783, 782, 840, 839,
+    897, 896, 954, 953, 1011, 1010, 1068, 1067, 1125, 1124,
+    1182, 1181, 1239, 1238, 1296, 1295, 1353, 1352, 1410, 1409,
+    1467, 1466, 1524, 1523, 1581, 1580, 1638, 1637, 1695, 1694,
+    1752, 1751, 1809, 1808, 1866, 1865, 1923, 1922, 1980, 1979,
+    2037, 2036, 2094, 2093, 2151, 2150, 2208, 2207, 2265, 2264,
+    2322, 2321, 2379, 2378, 2436, 2435, 2493, 2492, 2550, 2549,
+    2607, 2606, 2664, 2663, 2721, 2720, 2778, 2777, 2835, 2834,
+    2892, 2891, 2949, 2948, 3006, 3005, 3063, 3062, 3120, 3119,
+    3177, 3176, 3234, 3233, 3232, 3231, 3175, 3174, 3118, 3117,
+    3061, 3060, 3004, 3003, 2947, 2946, 2890, 2889, 2833, 2832,
+    2776, 2775, 2719, 2718, 2662, 2661, 2605, 2604, 2548, 2547,
+    2491, 2490, 2434, 2433, 2377, 2376, 2320, 2319, 2263, 2262,
+    2206, 2205, 2149, 2148, 2092, 2091, 2035, 2034, 1978, 1977,
+    1921, 1920, 1864, 1863, 1807, 1806, 1750, 1749, 1693, 1692,
+    1636, 1635, 1579, 1578, 1522, 1521, 1465, 1464, 1408, 1407,
+    1351, 1350, 1294, 1293, 1237, 1236, 1180, 1179, 1123, 1122,
+    1066, 1065, 1009, 1008, 952, 951, 895, 894, 838, 837,
+    781, 780, 724, 723, 667, 666, 610, 609, 553, 552,
+    496, 495, 439, 438, 325, 324, 268, 267, 211, 210,
+    154, 153, 97, 96, 40, 39, 38, 37, 95, 94,
+    152, 151, 209, 208, 266, 265, 323, 322, 437, 436,
+    494, 493, 551, 550, 608, 607, 665, 664, 722, 721,
+    779, 778, 836, 835, 893, 892, 950, 949, 1007, 1006,
+    1064, 1063, 1121, 1120, 1178, 1177, 1235, 1234, 1292, 1291,
+    1349, 1348, 1406, 1405, 1463, 1462, 1520, 1519, 1577, 1576,
+    1634, 1633, 1691, 1690, 1748, 1747, 1805, 1804, 1862, 1861,
+    1919, 1918, 1976, 1975, 2033, 2032, 2090, 2089, 2147, 2146,
+    2204, 2203, 2261, 2260, 2318, 2317, 2375, 2374, 2432, 2431,
+    2489, 2488, 2546, 2545, 2603, 2602, 2660, 2659, 2717, 2716,
+    2774, 2773, 2831, 2830, 2888, 2887, 2945, 2944, 3002, 3001,
+    3059, 3058, 3116, 3115, 3173, 3172, 3230, 3229, 3228, 3227,
+    3171, 3170, 3114, 3113, 3057, 3056, 3000, 2999, 2943, 2942,
+    2886, 2885, 2829, 2828, 2772, 2771, 2715, 2714, 2658, 2657,
+    2601, 2600, 2544, 2543, 2487, 2486, 2430, 2429, 2373, 2372,
+    2316, 2315, 2259, 2258, 2202, 2201, 2145, 2144, 2088, 2087,
+    2031, 2030, 1974, 1973, 1917, 1916, 1860, 1859, 1803, 1802,
+    1746, 1745, 1689, 1688, 1632, 1631, 1575, 1574, 1518, 1517,
+    1461, 1460, 1404, 1403, 1347, 1346, 1290, 1289, 1233, 1232,
+    1176, 1175, 1119, 1118, 1062, 1061, 1005, 1004, 948, 947,
+    891, 890, 834, 833, 777, 776, 720, 719, 663, 662,
+    606, 605, 549, 548, 492, 491, 435, 434, 321, 320,
+    264, 263, 207, 206, 150, 149, 93, 92, 36, 35,
+    34, 33, 91, 90, 148, 147, 205, 204, 262, 261,
+    319, 318, 433, 432, 490, 489, 547, 546, 604, 603,
+    661, 660, 718, 717, 775, 774, 832, 831, 889, 888,
+    946, 945, 1003, 1002, 1060, 1059, 1117, 1116, 1174, 1173,
+    1231, 1230, 1288, 1287, 1345, 1344, 1402, 1401, 1459, 1458,
+    1516, 1515, 1573, 1572, 1630, 1629, 1687, 1686, 1744, 1743,
+    1801, 1800, 1858, 1857, 1915, 1914, 1972, 1971, 2029, 2028,
+    2086, 2085, 2143, 2142, 2200, 2199, 2257, 2256, 2314, 2313,
+    2371, 2370, 2428, 2427, 2485, 2484, 2542, 2541, 2599, 2598,
+    2656, 2655, 2713, 2712, 2770, 2769, 2827, 2826, 2884, 2883,
+    2941, 2940, 2998, 2997, 3055, 3054, 3112, 3111, 3169, 3168,
+    3226, 3225, 3224, 3223, 3167, 3166, 3110, 3109, 3053, 3052,
+    2996, 2995, 2939, 2938, 2882, 2881, 2825, 2824, 2768, 2767,
+    2711, 2710, 2654, 2653, 2597, 2596, 2540, 2539, 2483, 2482,
+    2426, 2425, 2369, 2368, 2312, 2311, 2255, 2254, 2198, 2197,
+    2141, 2140, 2084, 2083, 2027, 2026, 1970, 1969, 1913, 1912,
+    1856, 1855, 1799, 1798, 1742, 1741, 1685, 1684, 1628, 1627,
+    1571, 1570, 1514, 1513, 1457, 1456, 1400, 1399, 1343, 1342,
+    1286, 1285, 1229, 1228, 1172, 1171, 1115, 1114, 1058, 1057,
+    1001, 1000, 944, 943, 887, 886, 830, 829, 773, 772,
+    716, 715, 659, 658, 602, 601, 545, 544, 488, 487,
+    431, 430, 317, 316, 260, 259, 203, 202, 146, 145,
+    89, 88, 32, 31, 30, 29, 87, 86, 144, 143,
+    201, 200, 543, 542, 600, 599, 657, 656, 714, 713,
+    771, 770, 828, 827, 885, 884, 942, 941, 999, 998,
+    1056, 1055, 1113, 1112, 1170, 1169, 1227, 1226, 1284, 1283,
+    1341, 1340, 1398, 1397, 1455, 1454, 1797, 1796, 1854, 1853,
+    1911, 1910, 1968, 1967, 2025, 2024, 2082, 2081, 2139, 2138,
+    2196, 2195, 2253, 2252, 2310, 2309, 2367, 2366, 2424, 2423,
+    2481, 2480, 2538, 2537, 2595, 2594, 2652, 2651, 2709, 2708,
+    3051, 3050, 3108, 3107, 3165, 3164, 3222, 3221, 3220, 3219,
+    3163, 3162, 3106, 3105, 3049, 3048, 2707, 2706, 2650, 2649,
+    2593, 2592, 2536, 2535, 2479, 2478, 2422, 2421, 2365, 2364,
+    2308, 2307, 2251, 2250, 2194, 2193, 2137, 2136, 2080, 2079,
+    2023, 2022, 1966, 1965, 1909, 1908, 1852, 1851, 1795, 1794,
+    1453, 1452, 1396, 1395, 1339, 1338, 1282, 1281, 1225, 1224,
+    1168, 1167, 1111, 1110, 1054, 1053, 997, 996, 940, 939,
+    883, 882, 826, 825, 769, 768, 712, 711, 655, 654,
+    598, 597, 541, 540, 199, 198, 142, 141, 85, 84,
+    28, 27, 26, 25, 83, 82, 140, 139, 197, 196,
+    253, 310, 424, 481, 539, 538, 596, 595, 653, 652,
+    710, 709, 767, 766, 824, 823, 881, 880, 938, 937,
+    995, 994, 1052, 1051, 1109, 1108, 1166, 1165, 1223, 1222,
+    1280, 1279, 1337, 1336, 1394, 1393, 1451, 1450, 1507, 1564,
+    1621, 1678, 1735, 1793, 1792, 1850, 1849, 1907, 1906, 1964,
+    1963, 2021, 2020, 2078, 2077, 2135, 2134, 2192, 2191, 2249,
+    2248, 2306, 2305, 2363, 2362, 2420, 2419, 2477, 2476, 2534,
+    2533, 2591, 2590, 2648, 2647, 2705, 2704, 2761, 2818, 2875,
+    2932, 2989, 3047, 3046, 3104, 3103, 3161, 3160, 3218, 3217,
+    3216, 3215, 3159, 3158, 3102, 3101, 3045, 3044, 2988, 2987,
+    2931, 2930, 2874, 2873, 2817, 2816, 2760, 2759, 2703, 2702,
+    2646, 2645, 2589, 2588, 2532, 2531, 2475, 2474, 2418, 2417,
+    2361, 2360, 2304, 2303, 2247, 2246, 2190, 2189, 2133, 2132,
+    2076, 2075, 2019, 2018, 1962, 1961, 1905, 1904, 1848, 1847,
+    1791, 1790, 1734, 1733, 1677, 1676, 1620, 1619, 1563, 1562,
+    1506, 1505, 1449, 1448, 1392, 1391, 1335, 1334, 1278, 1277,
+    1221, 1220, 1164, 1163, 1107, 1106, 1050, 1049, 993, 992,
+    936, 935, 879, 878, 822, 821, 765, 764, 708, 707,
+    651, 650, 594, 593, 537, 536, 480, 479, 423, 422,
+    309, 308, 252, 251, 195, 194, 138, 137, 81, 80,
+    24, 23, 22, 21, 79, 78, 136, 135, 193, 192,
+    250, 249, 307, 306, 421, 420, 478, 477, 535, 534,
+    592, 591, 649, 648, 706, 705, 763, 762, 820, 819,
+    877, 876, 934, 933, 991, 990, 1048, 1047, 1105, 1104,
+    1162, 1161, 1219, 1218, 1276, 1275, 1333, 1332, 1390, 1389,
+    1447, 1446, 1504, 1503, 1561, 1560, 1618, 1617, 1675, 1674,
+    1732, 1731, 1789, 1788, 1846, 1845, 1903, 1902, 1960, 1959,
+    2017, 2016, 2074, 2073, 2131, 2130, 2188, 2187, 2245, 2244,
+    2302, 2301, 2359, 2358, 2416, 2415, 2473, 2472, 2530, 2529,
+    2587, 2586, 2644, 2643, 2701, 2700, 2758, 2757, 2815, 2814,
+    2872, 2871, 2929, 2928, 2986, 2985, 3043, 3042, 3100, 3099,
+    3157, 3156, 3214, 3213, 3212, 3211, 3155, 3154, 3098, 3097,
+    3041, 3040, 2984, 2983, 2927, 2926, 2870, 2869, 2813, 2812,
+    2756, 2755, 2699, 2698, 2642, 2641, 2585, 2584, 2528, 2527,
+    2471, 2470, 2414, 2413, 2357, 2356, 2300, 2299, 2243, 2242,
+    2186, 2185, 2129, 2128, 2072, 2071, 2015, 2014, 1958, 1957,
+    1901, 1900, 1844, 1843, 1787, 1786, 1730, 1729, 1673, 1672,
+    1616, 1615, 1559, 1558, 1502, 1501, 1445, 1444, 1388, 1387,
+    1331, 1330, 1274, 1273, 1217, 1216, 1160, 1159, 1103, 1102,
+    1046, 1045, 989, 988, 932, 931, 875, 874, 818, 817,
+    761, 760, 704, 703, 647, 646, 590, 589, 533, 532,
+    476, 475, 419, 418, 305, 304, 248, 247, 191, 190,
+    134, 133, 77, 76, 20, 19, 18, 17, 75, 74,
+    132, 131, 189, 188, 246, 245, 303, 302, 417, 416,
+    474, 473, 531, 530, 588, 587, 645, 644, 702, 701,
+    759, 758, 816, 815, 873, 872, 930, 929, 987, 986,
+    1044, 1043, 1101, 1100, 1158, 1157, 1215, 1214, 1272, 1271,
+    1329, 1328, 1386, 1385, 1443, 1442, 1500, 1499, 1557, 1556,
+    1614, 1613, 1671, 1670, 1728, 1727, 1785, 1784, 1842, 1841,
+    1899, 1898, 1956, 1955, 2013, 2012, 2070, 2069, 2127, 2126,
+    2184, 2183, 2241, 2240, 2298, 2297, 2355, 2354, 2412, 2411,
+    2469, 2468, 2526, 2525, 2583, 2582, 2640, 2639, 2697, 2696,
+    2754, 2753, 2811, 2810, 2868, 2867, 2925, 2924, 2982, 2981,
+    3039, 3038, 3096, 3095, 3153, 3152, 3210, 3209, 3208, 3207,
+    3151, 3150, 3094, 3093, 3037, 3036, 2980, 2979, 2923, 2922,
+    2866, 2865, 2809, 2808, 2752, 2751, 2695, 2694, 2638, 2637,
+    2581, 2580, 2524, 2523, 2467, 2466, 2410, 2409, 2353, 2352,
+    2296, 2295, 2239, 2238, 2182, 2181, 2125, 2124, 2068, 2067,
+    2011, 2010, 1954, 1953, 1897, 1896, 1840, 1839, 1783, 1782,
+    1726, 1725, 1669, 1668, 1612, 1611, 1555, 1554, 1498, 1497,
+    1441, 1440, 1384, 1383, 1327, 1326, 1270, 1269, 1213, 1212,
+    1156, 1155, 1099, 1098, 1042, 1041, 985, 984, 928, 927,
+    871, 870, 814, 813, 757, 756, 700, 699, 643, 642,
+    586, 585, 529, 528, 472, 471, 415, 414, 301, 300,
+    244, 243, 187, 186, 130, 129, 73, 72, 16, 15,
+    14, 13, 71, 70, 128, 127, 185, 184, 242, 241,
+    299, 298, 413, 412, 470, 469, 527, 526, 584, 583,
+    641, 640, 698, 697, 755, 754, 812, 811, 869, 868,
+    926, 925, 983, 982, 1040, 1039, 1097, 1096, 1154, 1153,
+    1211, 1210, 1268, 1267, 1325, 1324, 1382, 1381, 1439, 1438,
+    1496, 1495, 1553, 1552, 1610, 1609, 1667, 1666, 1724, 1723,
+    1781, 1780, 1838, 1837, 1895, 1894, 1952, 1951, 2009, 2008,
+    2066, 2065, 2123, 2122, 2180, 2179, 2237, 2236, 2294, 2293,
+    2351, 2350, 2408, 2407, 2465, 2464, 2522, 2521, 2579, 2578,
+    2636, 2635, 2693, 2692, 2750, 2749, 2807, 2806, 2864, 2863,
+    2921, 2920, 2978, 2977, 3035, 3034, 3092, 3091, 3149, 3148,
+    3206, 3205, 3204, 3203, 3147, 3146, 3090, 3089, 3033, 3032,
+    2976, 2975, 2919, 2918, 2862, 2861, 2805, 2804, 2748, 2747,
+    2691, 2690, 2634, 2633, 2577, 2576, 2520, 2519, 2463, 2462,
+    2406, 2405, 2349, 2348, 2292, 2291, 2235, 2234, 2178, 2177,
+    2121, 2120, 2064, 2063, 2007, 2006, 1950, 1949, 1893, 1892,
+    1836, 1835, 1779, 1778, 1722, 1721, 1665, 1664, 1608, 1607,
+    1551, 1550, 1494, 1493, 1437, 1436, 1380, 1379, 1323, 1322,
+    1266, 1265, 1209, 1208, 1152, 1151, 1095, 1094, 1038, 1037,
+    981, 980, 924, 923, 867, 866, 810, 809, 753, 752,
+    696, 695, 639, 638, 582, 581, 525, 524, 468, 467,
+    411, 410, 297, 296, 240, 239, 183, 182, 126, 125,
+    69, 68, 12, 11, 10, 9, 67, 66, 124, 123,
+    181, 180, 238, 237, 295, 294, 409, 408, 466, 465,
+    523, 522, 580, 579, 637, 636, 694, 693, 751, 750,
+    808, 807, 865, 864, 922, 921, 979, 978, 1036, 1035,
+    1093, 1092, 1150, 1149, 1207, 1206, 1264, 1263, 1321, 1320,
+    1378, 1377, 1435, 1434, 1492, 1491, 1549, 1548, 1606, 1605,
+    1663, 1662, 1720, 1719, 1777, 1776, 1834, 1833, 1891, 1890,
+    1948, 1947, 2005, 2004, 2062, 2061, 2119, 2118, 2176, 2175,
+    2233, 2232, 2290, 2289, 2347, 2346, 2404, 2403, 2461, 2460,
+    2518, 2517, 2575, 2574, 2632, 2631, 2689, 2688, 2746, 2745,
+    2803, 2802, 2860, 2859, 2917, 2916, 2974, 2973, 3031, 3030,
+    3088, 3087, 3145, 3144, 3202, 3201, 2744, 2743, 2687, 2686,
+    2630, 2629, 2573, 2572, 2516, 2515, 2459, 2458, 2402, 2401,
+    2345, 2344, 2288, 2287, 2231, 2230, 2174, 2173, 2117, 2116,
+    2060, 2059, 2003, 2002, 1946, 1945, 1889, 1888, 1832, 1831,
+    1775, 1774, 1433, 1432, 1376, 1375, 1319, 1318, 1262, 1261,
+    1205, 1204, 1148, 1147, 1091, 1090, 1034, 1033, 977, 976,
+    920, 919, 863, 862, 806, 805, 749, 748, 692, 691,
+    635, 634, 578, 577, 521, 520, 518, 517, 575, 574,
+    632, 631, 689, 688, 746, 745, 803, 802, 860, 859,
+    917, 916, 974, 973, 1031, 1030, 1088, 1087, 1145, 1144,
+    1202, 1201, 1259, 1258, 1316, 1315, 1373, 1372, 1430, 1429,
+    1772, 1771, 1829, 1828, 1886, 1885, 1943, 1942, 2000, 1999,
+    2057, 2056, 2114, 2113, 2171, 2170, 2228, 2227, 2285, 2284,
+    2342, 2341, 2399, 2398, 2456, 2455, 2513, 2512, 2570, 2569,
+    2568, 2567, 2511, 2510, 2454, 2453, 2397, 2396, 2340, 2339,
+    2283, 2282, 2226, 2225, 2169, 2168, 2112, 2111, 2055, 2054,
+    1998, 1997, 1941, 1940, 1884, 1883, 1827, 1826, 1770, 1769,
+    1713, 1712, 1656, 1655, 1599, 1598, 1542, 1541, 1485, 1484,
+    1428, 1427, 1371, 1370, 1314, 1313, 1257, 1256, 1200, 1199,
+    1143, 1142, 1086, 1085, 1029, 1028, 972, 971, 915, 914,
+    858, 857, 801, 800, 744, 743, 687, 686, 630, 629,
+    573, 572, 516, 515, 514, 513, 571, 570, 628, 627,
+    685, 684, 742, 741, 799, 798, 856, 855, 913, 912,
+    970, 969, 1027, 1026, 1084, 1083, 1141, 1140, 1198, 1197,
+    1255, 1254, 1312, 1311, 1369, 1368, 1426, 1425, 1483, 1482,
+    1540, 1539, 1597, 1596, 1654, 1653, 1711, 1710, 1768, 1767,
+    1825, 1824, 1882, 1881, 1939, 1938, 1996, 1995, 2053, 2052,
+    2110, 2109, 2167, 2166, 2224, 2223, 2281, 2280, 2338, 2337,
+    2395, 2394, 2452, 2451, 2509, 2508, 2566, 2565};
+#endif
+
+const struct quirc_version_tables quirc_version_tables[QUIRC_MAX_VERSION + 1] = {
+    {.data_cells = 0},
+    {/* Version 1 */
+     .layout = {
+         {.blocks = 1, .ecc_offset = 16},
+         {.blocks = 1, .ecc_offset = 19},
+         {.blocks = 1, .ecc_offset = 9},
+         {.blocks = 1, .ecc_offset = 13}},
+     .data_cells = 208,
+#if QUIRC_TABLE_VERSIONS >= 1
+     .data_order = data_order_1
+#endif
+    },
+    {/* Version 2 */
+     .layout = {
+         {.blocks = 1, .ecc_offset = 28},
+         {.blocks = 1, .ecc_offset = 34},
+         {.blocks = 1, .ecc_offset = 16},
+         {.blocks = 1, .ecc_offset = 22}},
+     .data_cells = 359,
+#if QUIRC_TABLE_VERSIONS >= 2
+     .data_order = data_order_2
+#endif
+    },
+    {/* Version 3 */
+     .layout = {
+         {.blocks = 1, .ecc_offset = 44},
+         {.blocks = 1, .ecc_offset = 55},
+         {.blocks = 2, .ecc_offset = 26},
+         {.blocks = 2, .ecc_offset = 34}},
+     .data_cells = 567,
+#if QUIRC_TABLE_VERSIONS >= 3
+     .data_order = data_order_3
+#endif
+    },
+    {/* Version 4 */
+     .layout = {
+         {.blocks = 2, .ecc_offset = 64},
+         {.blocks = 1, .ecc_offset = 80},
+         {.blocks = 4, .ecc_offset = 36},
+         {.blocks = 2, .ecc_offset = 48}},
+     .data_cells = 807,
+#if QUIRC_TABLE_VERSIONS >= 4
+     .data_order = data_order_4
+#endif
+    },
+    {/* Version 5 */
+     .layout = {
+         {.blocks = 2, .ecc_offset = 86},
+         {.blocks = 1, .ecc_offset = 108},
+         {.blocks = 4, .ecc_offset = 46},
+         {.blocks = 4, .ecc_offset = 62}},
+     .data_cells = 1079,
+#if QUIRC_TABLE_VERSIONS >= 5
+     .data_order = data_order_5
+#endif
+    },
+    {/* Version 6 */
+     .layout = {
+         {.blocks = 4, .ecc_offset = 108},
+         {.blocks = 2, .ecc_offset = 136},
+         {.blocks = 4, .ecc_offset = 60},
+         {.blocks = 4, .ecc_offset = 76}},
+     .data_cells = 1383,
+#if QUIRC_TABLE_VERSIONS >= 6
+     .data_order = data_order_6
+#endif
+    },
+    {/* Version 7 */
+     .layout = {
+         {.blocks = 4, .ecc_offset = 124},
+         {.blocks = 2, .ecc_offset = 156},
+         {.blocks = 5, .ecc_offset = 66},
+         {.blocks = 6, .ecc_offset = 88}},
+     .data_cells = 1568,
+#if QUIRC_TABLE_VERSIONS >= 7
+     .data_order = data_order_7
+#endif
+    },
+    {/* Version 8 */
+     .layout = {
+         {.blocks = 4, .ecc_offset = 154},
+         {.blocks = 2, .ecc_offset = 194},
+         {.blocks = 6, .ecc_offset = 86},
+         {.blocks = 6, .ecc_offset = 110}},
+     .data_cells = 1936,
+#if QUIRC_TABLE_VERSIONS >= 8
+     .data_order = data_order_8
+#endif
+    },
+    {/* Version 9 */
+     .layout = {
+         {.blocks = 5, .ecc_offset = 182},
+         {.blocks = 2, .ecc_offset = 232},
+         {.blocks = 8, .ecc_offset = 100},
+         {.blocks = 8, .ecc_offset = 132}},
+     .data_cells = 2336,
+#if QUIRC_TABLE_VERSIONS >= 9
+     .data_order = data_order_9
+#endif
+    },
+    {/* Version 10 */
+     .layout = {
+         {.blocks = 5, .ecc_offset = 216},
+         {.blocks = 4, .ecc_offset = 274},
+         {.blocks = 8, .ecc_offset = 122},
+         {.blocks = 8, .ecc_offset = 154}},
+     .data_cells = 2768,
+#if QUIRC_TABLE_VERSIONS >= 10
+     .data_order = data_order_10
+#endif
+    },
+    {/* Version 11 */
+     .layout = {
+         {.blocks = 5, .ecc_offset = 254},
+         {.blocks = 4, .ecc_offset = 324},
+         {.blocks = 11, .ecc_offset = 140},
+         {.blocks = 8, .ecc_offset = 180}},
+     .data_cells = 3232,
+    },
+    {/* Version 12 */
+     .layout = {
+         {.blocks = 8, .ecc_offset = 290},
+         {.blocks = 4, .ecc_offset = 370},
+         {.blocks = 11, .ecc_offset = 158},
+         {.blocks = 10, .ecc_offset = 206}},
+     .data_cells = 3728,
+    },
+    {/* Version 13 */
+     .layout = {
+         {.blocks = 9, .ecc_offset = 334},
+         {.blocks = 4, .ecc_offset = 428},
+         {.blocks = 16, .ecc_offset = 180},
+         {.blocks = 12, .ecc_offset = 244}},
+     .data_cells = 4256,
+    },
+    {/* Version 14 */
+     .layout = {
+         {.blocks = 9, .ecc_offset = 365},
+         {.blocks = 4, .ecc_offset = 461},
+         {.blocks = 16, .ecc_offset = 197},
+         {.blocks = 16, .ecc_offset = 261}},
+     .data_cells = 4651,
+    },
+    {/* Version 15 */
+     .layout = {
+         {.blocks = 10, .ecc_offset = 415},
+         {.blocks = 6, .ecc_offset = 523},
+         {.blocks = 18, .ecc_offset = 223},
+         {.blocks = 12, .ecc_offset = 295}},
+     .data_cells = 5243,
+    },
+    {/* Version 16 */
+     .layout = {
+         {.blocks = 10, .ecc_offset = 453},
+         {.blocks = 6, .ecc_offset = 589},
+         {.blocks = 16, .ecc_offset = 253},
+         {.blocks = 17, .ecc_offset = 325}},
+     .data_cells = 5867,
+    },
+    {/* Version 17 */
+     .layout = {
+         {.blocks = 11, .ecc_offset = 507},
+         {.blocks = 6, .ecc_offset = 647},
+         {.blocks = 19, .ecc_offset = 283},
+         {.blocks = 16, .ecc_offset = 367}},
+     .data_cells = 6523,
+    },
+    {/* Version 18 */
+     .layout = {
+         {.blocks = 13, .ecc_offset = 563},
+         {.blocks = 6, .ecc_offset = 721},
+         {.blocks = 21, .ecc_offset = 313},
+         {.blocks = 18, .ecc_offset = 397}},
+     .data_cells = 7211,
+    },
+    {/* Version 19 */
+     .layout = {
+         {.blocks = 14, .ecc_offset = 627},
+         {.blocks = 7, .ecc_offset = 795},
+         {.blocks = 25, .ecc_offset = 341},
+         {.blocks = 21, .ecc_offset = 445}},
+     .data_cells = 7931,
+    },
+    {/* Version 20 */
+     .layout = {
+         {.blocks = 16, .ecc_offset = 669},
+         {.blocks = 8, .ecc_offset = 861},
+         {.blocks = 25, .ecc_offset = 385},
+         {.blocks = 20, .ecc_offset = 485}},
+     .data_cells = 8683,
+    },
+    {/* Version 21 */
+     .layout = {
+         {.blocks = 17, .ecc_offset = 714},
+         {.blocks = 8, .ecc_offset = 932},
+         {.blocks = 25, .ecc_offset = 406},
+         {.blocks = 23, .ecc_offset = 512}},
+     .data_cells = 9252,
+    },
+    {/* Version 22 */
+     .layout = {
+         {.blocks = 17, .ecc_offset = 782},
+         {.blocks = 9, .ecc_offset = 1006},
+         {.blocks = 34, .ecc_offset = 442},
+         {.blocks = 23, .ecc_offset = 568}},
+     .data_cells = 10068,
+    },
+    {/* Version 23 */
+     .layout = {
+         {.blocks = 18, .ecc_offset = 860},
+         {.blocks = 9, .ecc_offset = 1094},
+         {.blocks = 30, .ecc_offset = 464},
+         {.blocks = 25, .ecc_offset = 614}},
+     .data_cells = 10916,
+    },
+    {/* Version 24 */
+     .layout = {
+         {.blocks = 20, .ecc_offset = 914},
+         {.blocks = 10, .ecc_offset = 1174},
+         {.blocks = 32, .ecc_offset = 514},
+         {.blocks = 27, .ecc_offset = 664}},
+     .data_cells = 11796,
+    },
+    {/* Version 25 */
+     .layout = {
+         {.blocks = 21, .ecc_offset = 1000},
+         {.blocks = 12, .ecc_offset = 1276},
+         {.blocks = 35, .ecc_offset = 538},
+         {.blocks = 29, .ecc_offset = 718}},
+     .data_cells = 12708,
+    },
+    {/* Version 26 */
+     .layout = {
+         {.blocks = 23, .ecc_offset = 1062},
+         {.blocks = 12, .ecc_offset = 1370},
+         {.blocks = 37, .ecc_offset = 596},
+         {.blocks = 34, .ecc_offset = 754}},
+     .data_cells = 13652,
+    },
+    {/* Version 27 */
+     .layout = {
+         {.blocks = 25, .ecc_offset = 1128},
+         {.blocks = 12, .ecc_offset = 1468},
+         {.blocks = 40, .ecc_offset = 628},
+         {.blocks = 34, .ecc_offset = 808}},
+     .data_cells = 14628,
+    },
+    {/* Version 28 */
+     .layout = {
+         {.blocks = 26, .ecc_offset = 1193},
+         {.blocks = 13, .ecc_offset = 1531},
+         {.blocks = 42, .ecc_offset = 661},
+         {.blocks = 35, .ecc_offset = 871}},
+     .data_cells = 15371,
+    },
+    {/* Version 29 */
+     .layout = {
+         {.blocks = 28, .ecc_offset = 1267},
+         {.blocks = 14, .ecc_offset = 1631},
+         {.blocks = 45, .ecc_offset = 701},
+         {.blocks = 38, .ecc_offset = 911}},
+     .data_cells = 16411,
+    },
+    {/* Version 30 */
+     .layout = {
+         {.blocks = 29, .ecc_offset = 1373},
+         {.blocks = 15, .ecc_offset = 1735},
+         {.blocks = 48, .ecc_offset = 745},
+         {.blocks = 40, .ecc_offset = 985}},
+     .data_cells = 17483,
+    },
+    {/* Version 31 */
+     .layout = {
+         {.blocks = 31, .ecc_offset = 1455},
+         {.blocks = 16, .ecc_offset = 1843},
+         {.blocks = 51, .ecc_offset = 793},
+         {.blocks = 43, .ecc_offset = 1033}},
+     .data_cells = 18587,
+    },
+    {/* Version 32 */
+     .layout = {
+         {.blocks = 33, .ecc_offset = 1541},
+         {.blocks = 17, .ecc_offset = 1955},
+         {.blocks = 54, .ecc_offset = 845},
+         {.blocks = 45, .ecc_offset = 1115}},
+     .data_cells = 19723,
+    },
+    {/* Version 33 */
+     .layout = {
+         {.blocks = 35, .ecc_offset = 1631},
+         {.blocks = 18, .ecc_offset = 2071},
+         {.blocks = 57, .ecc_offset = 901},
+         {.blocks = 48, .ecc_offset = 1171}},
+     .data_cells = 20891,
+    },
+    {/* Version 34 */
+     .layout = {
+         {.blocks = 37, .ecc_offset = 1725},
+         {.blocks = 19, .ecc_offset = 2191},
+         {.blocks = 60, .ecc_offset = 961},
+         {.blocks = 51, .ecc_offset = 1231}},
+     .data_cells = 22091,
+    },
+    {/* Version 35 */
+     .layout = {
+         {.blocks = 38, .ecc_offset = 1812},
+         {.blocks = 19, .ecc_offset = 2306},
+         {.blocks = 63, .ecc_offset = 986},
+         {.blocks = 53, .ecc_offset = 1286}},
+     .data_cells = 23008,
+    },
+    {/* Version 36 */
+     .layout = {
+         {.blocks = 40, .ecc_offset = 1914},
+         {.blocks = 20, .ecc_offset = 2434},
+         {.blocks = 66, .ecc_offset = 1054},
+         {.blocks = 56, .ecc_offset = 1354}},
+     .data_cells = 24272,
+    },
+    {/* Version 37 */
+     .layout = {
+         {.blocks = 43, .ecc_offset = 1992},
+         {.blocks = 21, .ecc_offset = 2566},
+         {.blocks = 70, .ecc_offset = 1096},
+         {.blocks = 59, .ecc_offset = 1426}},
+     .data_cells = 25568,
+    },
+    {/* Version 38 */
+     .layout = {
+         {.blocks = 45, .ecc_offset = 2102},
+         {.blocks = 22, .ecc_offset = 2702},
+         {.blocks = 74, .ecc_offset = 1142},
+         {.blocks = 62, .ecc_offset = 1502}},
+     .data_cells = 26896,
+    },
+    {/* Version 39 */
+     .layout = {
+         {.blocks = 47, .ecc_offset = 2216},
+         {.blocks = 24, .ecc_offset = 2812},
+         {.blocks = 77, .ecc_offset = 1222},
+         {.blocks = 65, .ecc_offset = 1582}},
+     .data_cells = 28256,
+    },
+    {/* Version 40 */
+     .layout = {
+         {.blocks = 49, .ecc_offset = 2334},
+         {.blocks = 25, .ecc_offset = 2956},
+         {.blocks = 81, .ecc_offset = 1276},
+         {.blocks = 68, .ecc_offset = 1666}},
+     .data_cells = 29648,
+    }};